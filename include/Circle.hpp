@@ -1,6 +1,5 @@
 #pragma once
 #include "PhysicsObject.hpp"
-#include "Renderer.hpp"
 
 class Circle : public PhysicsObject {
 private:
@@ -18,13 +17,12 @@ public:
     void setColor(const glm::vec3& c) { color = c; }
     const glm::vec3& getColor() const { return color; }
 
-    bool checkCollision(const PhysicsObject& other) const override;
-    void resolveCollision(PhysicsObject& other);
-    
-    void draw() const override {
-        Renderer::drawCircle(position, radius, color);
-        if (showVelocityVectors) {
-            Renderer::drawVelocityVector(position, velocity * 0.1f);
-        }
+    bool collide(const PhysicsObject& other, ContactManifold& manifold,
+                 SeparatingAxisCache* cache = nullptr) const override;
+    AABB getBounds() const override {
+        return AABB{position - glm::vec2(radius), position + glm::vec2(radius)};
     }
+    float getBoundingRadius() const override { return radius; }
+    glm::vec2 getSupportPoint(const glm::vec2&) const override { return glm::vec2(0.0f); }
+    float getCoreRadius() const override { return radius; }
 };
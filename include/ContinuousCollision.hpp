@@ -0,0 +1,53 @@
+#pragma once
+#include "PhysicsObject.hpp"
+#include "GJK.hpp"
+#include <vector>
+
+// Result of a continuous collision query
+struct TimeOfImpact {
+    bool hit{false};
+    float time{1.0f};          // Fraction of the swept motion in [0, 1]
+    glm::vec2 point{0.0f};     // First contact point in world space
+    glm::vec2 normal{0.0f};    // Contact normal pointing from the target to the moving body
+};
+
+class ContinuousCollision {
+private:
+    // Smallest t in [0, 1] at which the ray start + t * dir enters the circle
+    static bool rayCircle(const glm::vec2& start, const glm::vec2& dir,
+                          const glm::vec2& center, float radius, float& t);
+
+    // Smallest t in [0, 1] at which the ray enters the box [-extent, extent]
+    static bool rayBox(const glm::vec2& start, const glm::vec2& dir,
+                       const glm::vec2& extent, float& t);
+
+    // Smallest t in [0, 1] at which the ray enters a convex polygon (Cyrus-Beck).
+    // Winding is +1 for counter-clockwise vertices and -1 for clockwise ones.
+    static bool rayConvexPolygon(const glm::vec2& start, const glm::vec2& dir,
+                                 const glm::vec2* verts, size_t count, float winding, float& t);
+
+    // Closest point to p on the boundary of a convex polygon
+    static glm::vec2 closestPointOnBoundary(const glm::vec2& p, const std::vector<glm::vec2>& verts);
+
+public:
+    // Sweep a circle along displacement against a target held at its current pose.
+    // Pairs that already overlap at the start are left to the narrowphase.
+    // verts is scratch for the target's outline, kept by the caller between sweeps.
+    static TimeOfImpact sweepCircle(const glm::vec2& start, const glm::vec2& displacement,
+                                    float radius, const PhysicsObject& target,
+                                    std::vector<glm::vec2>& verts);
+
+    // Conservative advancement between two bodies that translate and rotate
+    // linearly from their start to their end pose. Each iteration advances by
+    // the current distance over a bound on the closing speed (relative linear
+    // speed plus angular speed times bounding radius), so it never steps past
+    // the first contact. The normal points from b to a.
+    static TimeOfImpact conservativeAdvancement(const PhysicsObject& a, const Pose& startA, const Pose& endA,
+                                                const PhysicsObject& b, const Pose& startB, const Pose& endB);
+
+    // Distance between two shapes at the given poses, zero when they overlap.
+    // pointA and pointB are the closest points on the two cores.
+    static float separation(const PhysicsObject& a, const Pose& poseA,
+                            const PhysicsObject& b, const Pose& poseB,
+                            glm::vec2& pointA, glm::vec2& pointB, float& radiusA, float& radiusB);
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include "PhysicsObject.hpp"
+
+struct DebugVertex {
+    glm::vec2 position;
+    glm::vec3 color;
+};
+
+// Debug geometry appended by the physics stages while they run: broadphase
+// bounds and grid cells, contact points and normals. It is handed to the
+// renderer with each snapshot and drawn in the frame's line and point batches.
+// The stages only append when built with COLLISION_DEBUG_DRAW; otherwise the
+// calls are compiled out and the lists stay empty.
+class DebugDraw {
+private:
+    std::vector<DebugVertex> lines; // Two vertices per segment
+    std::vector<DebugVertex> points;
+
+public:
+    void clear() {
+        lines.clear();
+        points.clear();
+    }
+
+    void line(const glm::vec2& from, const glm::vec2& to, const glm::vec3& color) {
+        lines.push_back({from, color});
+        lines.push_back({to, color});
+    }
+
+    void point(const glm::vec2& position, const glm::vec3& color) {
+        points.push_back({position, color});
+    }
+
+    void box(const AABB& bounds, const glm::vec3& color) {
+        glm::vec2 corners[4] = {
+            bounds.min,
+            glm::vec2(bounds.max.x, bounds.min.y),
+            bounds.max,
+            glm::vec2(bounds.min.x, bounds.max.y)
+        };
+        for (int i = 0; i < 4; i++) {
+            line(corners[i], corners[(i + 1) % 4], color);
+        }
+    }
+
+    const std::vector<DebugVertex>& getLines() const { return lines; }
+    const std::vector<DebugVertex>& getPoints() const { return points; }
+};
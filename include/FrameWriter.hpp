@@ -0,0 +1,54 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Writes captured frames to disk as binary PPM on a background thread, so
+// the loop that renders them only pays for the readback. Pixel buffers are
+// recycled between frames; submit() only blocks when the writer has fallen
+// maxPending frames behind.
+class FrameWriter {
+private:
+    struct Frame {
+        std::string path;
+        int width;
+        int height;
+        std::vector<uint8_t> pixels; // Tightly packed RGB rows, bottom row first as read from OpenGL
+    };
+
+    size_t maxPending;
+    std::deque<Frame> pending;
+    std::vector<std::vector<uint8_t>> freeBuffers;
+    size_t framesWritten{0};
+    bool stopping{false};
+    bool failed{false};
+    std::mutex mutex;
+    std::condition_variable frameQueued;
+    std::condition_variable frameDone;
+    std::thread worker;
+
+    void run();
+    static bool writePPM(const Frame& frame);
+
+public:
+    explicit FrameWriter(size_t maxPending = 8);
+    ~FrameWriter(); // Writes every frame still queued
+
+    FrameWriter(const FrameWriter&) = delete;
+    FrameWriter& operator=(const FrameWriter&) = delete;
+
+    // Storage for the next frame, reused from a frame already written when possible
+    std::vector<uint8_t> takeBuffer();
+
+    void submit(const std::string& path, int width, int height, std::vector<uint8_t> pixels);
+
+    // Block until every submitted frame is on disk
+    void finish();
+
+    size_t getFramesWritten();
+    bool hasFailed();
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "PhysicsObject.hpp"
+#include "Manifold.hpp"
+
+// Position and rotation of a body at one instant
+struct Pose {
+    glm::vec2 position{0.0f};
+    float rotation{0.0f};
+};
+
+// A shape placed at a pose and queried only through its support function.
+// Shapes are a convex core rounded by a radius (circles are a rounded point).
+class SupportShape {
+private:
+    const PhysicsObject* shape;
+    glm::vec2 position;
+    float cosA;
+    float sinA;
+
+public:
+    explicit SupportShape(const PhysicsObject& obj);
+    SupportShape(const PhysicsObject& obj, const Pose& pose);
+
+    // Farthest point of the core along a world space direction
+    glm::vec2 support(const glm::vec2& direction) const;
+    float getRadius() const { return shape->getCoreRadius(); }
+    const glm::vec2& getPosition() const { return position; }
+};
+
+// Result of a closest-distance query
+struct DistanceResult {
+    float distance{0.0f};   // Between the rounded shapes, zero when they touch or overlap
+    glm::vec2 pointA{0.0f}; // Closest point on the core of A
+    glm::vec2 pointB{0.0f}; // Closest point on the core of B
+    bool coresOverlap{false};
+};
+
+// Generic convex narrowphase: GJK for distance, EPA for penetration.
+// Works for any pair of shapes with a support function and never allocates.
+class GJK {
+private:
+    struct SimplexVertex {
+        glm::vec2 a;  // Support point on A
+        glm::vec2 b;  // Support point on B
+        glm::vec2 w;  // b - a, a point of the Minkowski difference
+        float u;      // Barycentric weight of the closest point
+    };
+
+    struct Simplex {
+        SimplexVertex v[3];
+        int count;
+    };
+
+    static SimplexVertex makeVertex(const SupportShape& a, const SupportShape& b, const glm::vec2& direction);
+    static void solve2(Simplex& simplex);
+    static void solve3(Simplex& simplex);
+
+    // Run GJK on the cores and leave the final simplex behind for EPA
+    static DistanceResult coreDistance(const SupportShape& a, const SupportShape& b, Simplex& simplex);
+
+    // Expanding polytope on overlapping cores: normal from A to B and core depth
+    static bool penetration(const SupportShape& a, const SupportShape& b, const Simplex& simplex,
+                            glm::vec2& normal, float& depth, glm::vec2& point);
+
+public:
+    static DistanceResult distance(const SupportShape& a, const SupportShape& b);
+    static DistanceResult distance(const PhysicsObject& a, const PhysicsObject& b) {
+        return distance(SupportShape(a), SupportShape(b));
+    }
+
+    static ContactManifold collide(const SupportShape& a, const SupportShape& b);
+    static ContactManifold collide(const PhysicsObject& a, const PhysicsObject& b) {
+        return collide(SupportShape(a), SupportShape(b));
+    }
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include "PhysicsWorld.hpp"
+
+struct RenderSnapshot;
+
+// Performance overlay drawn over the scene in pixel coordinates. Everything it
+// shows comes from counters that already exist: the world's phase timings and
+// pair counts carried by each snapshot, and the frame and draw times the
+// viewer passes to recordFrame().
+class Hud {
+private:
+    static const int GRAPH_SAMPLES = 120;
+    static const int STEPS_PER_REFRESH = 60; // Phase times are averaged over this many steps
+
+    std::vector<float> frameTimes = std::vector<float>(GRAPH_SAMPLES, 0.0f); // Ring of recent frame times in ms
+    int nextSample{0};
+    float lastDrawMs{0.0f};
+
+    // Phase times per step, refreshed every STEPS_PER_REFRESH steps
+    PhaseTimings lastTimings;
+    PhaseTimings stepAverages;
+
+    void drawText(const glm::vec2& topLeft, const std::string& text, const glm::vec3& color) const;
+    void drawGraph(const glm::vec2& bottomLeft, const glm::vec2& size) const;
+
+public:
+    static const int PIXEL_SIZE = 2; // Screen pixels per font pixel
+
+    // Wall-clock time of the last frame and of the scene draw within it
+    void recordFrame(float frameMs, float drawMs);
+
+    // Draw over the current frame, then restore the scene's projection
+    void draw(const RenderSnapshot& snapshot, int framebufferWidth, int framebufferHeight);
+};
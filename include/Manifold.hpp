@@ -0,0 +1,19 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Narrowphase result for a pair of shapes
+struct ContactManifold {
+    bool hit{false};
+    glm::vec2 normal{0.0f};  // Unit normal pointing from the first shape to the second
+    float depth{0.0f};       // Penetration depth along the normal
+    int pointCount{0};
+    glm::vec2 points[2];     // Contact points in world space
+};
+
+// Per-pair memory of the face that last separated two shapes, so the next
+// query can test it first and reject a still-separated pair in one projection
+struct SeparatingAxisCache {
+    int owner{-1};             // 0: face of the first shape, 1: of the second, -1: empty
+    int face{0};               // Face index on the owning shape
+    bool cachedReject{false};  // Set when the cached face alone separated the pair
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// OpenGL context with an offscreen pbuffer and no display server, created
+// through EGL (surfaceless on Mesa, e.g. llvmpipe). Once initialized it is
+// current on the calling thread and the Renderer draws into it as into a window.
+class OffscreenContext {
+private:
+    void* display{nullptr}; // EGLDisplay, EGLSurface and EGLContext kept opaque
+    void* surface{nullptr}; // so the EGL headers stay out of this one
+    void* context{nullptr};
+    int width{0};
+    int height{0};
+
+public:
+    OffscreenContext() = default;
+    ~OffscreenContext();
+
+    OffscreenContext(const OffscreenContext&) = delete;
+    OffscreenContext& operator=(const OffscreenContext&) = delete;
+
+    // Create the context and make it current; prints the reason and returns false on failure
+    bool initialize(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Read the finished frame as tightly packed RGB rows, bottom row first
+    void readPixels(std::vector<uint8_t>& pixels) const;
+};
@@ -1,5 +1,18 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cmath>
+#include "Manifold.hpp"
+
+// Axis-aligned bounding box in world space
+struct AABB {
+    glm::vec2 min;
+    glm::vec2 max;
+
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y;
+    }
+};
 
 class PhysicsObject {
 protected:
@@ -8,11 +21,13 @@ protected:
     glm::vec2 acceleration;// Acceleration vector
     float angularVelocity; // Angular velocity (radians per second)
     float rotation;        // Current rotation in radians
+    glm::vec2 rotor;       // Cached (cos, sin) of the rotation
     float mass;           // Mass of the object
     float restitution;    // Coefficient of restitution (bounciness)
     float friction;       // Coefficient of friction
     float dragCoefficient;// Air resistance coefficient
     bool isStatic;        // If true, object won't move (like walls)
+    bool isBullet;        // If true, motion is swept each step to prevent tunneling
     static bool showVelocityVectors; // Flag to show/hide velocity vectors
     static const glm::vec2 GRAVITY;  // Gravity vector
 
@@ -26,11 +41,13 @@ public:
         , acceleration(glm::vec2(0.0f))
         , angularVelocity(0.0f)
         , rotation(0.0f)
+        , rotor(1.0f, 0.0f)
         , mass(m)
         , restitution(rest)
         , friction(0.3f)
         , dragCoefficient(0.1f)
         , isStatic(staticObj)
+        , isBullet(false)
     {}
 
     virtual ~PhysicsObject() = default;
@@ -40,8 +57,18 @@ public:
     static bool getShowVelocityVectors() { return showVelocityVectors; }
 
     // Pure virtual functions
-    virtual bool checkCollision(const PhysicsObject& other) const = 0;
-    virtual void draw() const = 0;
+    // Narrowphase query: fills in the normal (from this shape to the other),
+    // depth and contact points in the same pass that detects the overlap.
+    // SAT shapes read and refresh the optional per-pair axis cache.
+    virtual bool collide(const PhysicsObject& other, ContactManifold& manifold,
+                         SeparatingAxisCache* cache = nullptr) const = 0;
+    virtual AABB getBounds() const = 0;
+    virtual float getBoundingRadius() const = 0; // Radius of a circle around the position enclosing the shape
+
+    // Convex core in local space: farthest point along a local direction,
+    // and the radius the core is rounded by
+    virtual glm::vec2 getSupportPoint(const glm::vec2& localDirection) const = 0;
+    virtual float getCoreRadius() const { return 0.0f; }
 
     // Getters
     const glm::vec2& getPosition() const { return position; }
@@ -49,23 +76,50 @@ public:
     const glm::vec2& getAcceleration() const { return acceleration; }
     float getAngularVelocity() const { return angularVelocity; }
     float getRotation() const { return rotation; }
+    const glm::vec2& getRotor() const { return rotor; }
     float getMass() const { return mass; }
     float getRestitution() const { return restitution; }
     float getFriction() const { return friction; }
     float getDragCoefficient() const { return dragCoefficient; }
     bool getIsStatic() const { return isStatic; }
+    bool getIsBullet() const { return isBullet; }
 
     // Setters
     void setPosition(const glm::vec2& pos) { position = pos; }
     void setVelocity(const glm::vec2& vel) { velocity = vel; }
     void setAcceleration(const glm::vec2& acc) { acceleration = acc; }
     void setAngularVelocity(float angVel) { angularVelocity = angVel; }
-    void setRotation(float rot) { rotation = rot; }
+    void setRotation(float rot) {
+        rotation = rot;
+        rotor = glm::vec2(std::cos(rot), std::sin(rot));
+    }
     void setMass(float m) { mass = m; }
     void setRestitution(float r) { restitution = r; }
     void setFriction(float f) { friction = f; }
     void setDragCoefficient(float d) { dragCoefficient = d; }
     void setStatic(bool s) { isStatic = s; }
+    void setBullet(bool b) { isBullet = b; }
+
+    // Overlap test only, for callers that do not need the contact data
+    bool checkCollision(const PhysicsObject& other) const {
+        ContactManifold manifold;
+        return collide(other, manifold);
+    }
+
+    // Cheap reject before exact tests: do the bounding circles overlap?
+    bool boundingCirclesOverlap(const PhysicsObject& other) const {
+        glm::vec2 d = other.position - position;
+        float reach = getBoundingRadius() + other.getBoundingRadius();
+        return glm::dot(d, d) <= reach * reach;
+    }
+
+    // Rotate a vector by the body's rotation, or by its inverse
+    glm::vec2 rotateToWorld(const glm::vec2& v) const {
+        return glm::vec2(v.x * rotor.x - v.y * rotor.y, v.x * rotor.y + v.y * rotor.x);
+    }
+    glm::vec2 rotateToLocal(const glm::vec2& v) const {
+        return glm::vec2(v.x * rotor.x + v.y * rotor.y, -v.x * rotor.y + v.y * rotor.x);
+    }
 
     // Apply force
     void applyForce(const glm::vec2& force) {
@@ -105,8 +159,15 @@ public:
         // Update position using velocity
         position += velocity * deltaTime;
 
-        // Update rotation using angular velocity
-        rotation += angularVelocity * deltaTime;
+        // Update rotation using angular velocity, composing the cached rotor
+        // with this step's increment and renormalizing to stop drift
+        if (angularVelocity != 0.0f) {
+            float angle = angularVelocity * deltaTime;
+            rotation += angle;
+            glm::vec2 delta(std::cos(angle), std::sin(angle));
+            rotor = glm::vec2(rotor.x * delta.x - rotor.y * delta.y, rotor.x * delta.y + rotor.y * delta.x);
+            rotor *= 1.0f / std::sqrt(rotor.x * rotor.x + rotor.y * rotor.y);
+        }
 
         // Reset acceleration (forces are accumulated each frame)
         acceleration = glm::vec2(0.0f);
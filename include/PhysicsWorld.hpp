@@ -1,15 +1,150 @@
 #pragma once
+#include <array>
 #include <vector>
 #include <memory>
+#include <utility>
 #include "PhysicsObject.hpp"
+#include "DebugDraw.hpp"
+#include "WorkerPool.hpp"
+
+// How the broadphase finds candidate pairs
+enum class BroadphaseMode {
+    BruteForce,     // Test every pair of bounds
+    SweepAndPrune,  // Sort by min x and sweep
+    UniformGrid     // Bin bounds into square cells and test within each cell
+};
+
+// Wall-clock time spent in each phase of update(), accumulated until reset
+struct PhaseTimings {
+    double broadphase{0.0};  // Milliseconds
+    double narrowphase{0.0};
+    double solver{0.0};      // Impulses, position correction and boundaries
+    double integration{0.0}; // Forces, integration and bullet sweeps
+    size_t steps{0};
+};
+
+// Counts from the last update(), summed over its substeps and threads
+struct PipelineStats {
+    static constexpr int SHAPE_KINDS = 3;
+    static constexpr const char* SHAPE_NAMES[SHAPE_KINDS] = {"circle", "rectangle", "polygon"};
+
+    size_t dynamicBodies{0};
+    size_t staticBodies{0};
+    size_t candidatePairs{0};                            // Broadphase output
+    size_t narrowphaseTests[SHAPE_KINDS][SHAPE_KINDS]{}; // By shape kind, lower kind first
+    size_t hits{0};                                      // Tests that found an overlap
+    size_t contactPoints{0};
+    size_t speculativeContacts{0};
+    size_t solverIterations{0};                          // Velocity passes over the contacts
+    size_t allocations{0};                               // Scratch buffers that had to grow, the step's only heap allocations
+
+    size_t totalNarrowphaseTests() const {
+        size_t total = 0;
+        for (const auto& row : narrowphaseTests) {
+            for (size_t count : row) total += count;
+        }
+        return total;
+    }
+};
+
+// Touching pair together with the narrowphase result it was found with
+struct Contact {
+    size_t first;
+    size_t second;
+    ContactManifold manifold; // Normal points from first to second
+};
+
+// Contact for a separated pair that would close its gap within one substep
+struct SpeculativeContact {
+    size_t first;
+    size_t second;
+    glm::vec2 normal; // Points from second to first
+    float gap;        // Distance still allowed to close
+};
 
 class PhysicsWorld {
 private:
+    // One narrowphase thread's output and counters, on cache lines of its own
+    // so workers never write to a line another worker is using
+    struct alignas(64) NarrowphaseSlot {
+        std::vector<Contact> contacts;
+        std::vector<SpeculativeContact> speculativeContacts;
+        size_t tests[PipelineStats::SHAPE_KINDS][PipelineStats::SHAPE_KINDS];
+        size_t hits;
+        size_t contactPoints;
+        size_t axisCacheQueries;
+        size_t axisCacheHits;
+    };
+
     std::vector<std::shared_ptr<PhysicsObject>> objects;
+    std::vector<std::pair<size_t, size_t>> candidatePairs; // Broadphase output, built once per step
+    std::vector<Contact> contacts;                         // Narrowphase output, refreshed per substep
+    std::vector<SpeculativeContact> speculativeContacts;   // Approaching pairs, refreshed per substep
+    std::vector<SeparatingAxisCache> candidateAxes;        // Last separating face, one per candidate pair
+    std::vector<std::pair<size_t, size_t>> previousPairs;  // Last step's pairs while the axes are carried over
+    std::vector<SeparatingAxisCache> previousAxes;
+    std::vector<std::pair<uint64_t, size_t>> gridEntries;  // Uniform grid (cell, body) entries
+    std::vector<NarrowphaseSlot> narrowphaseSlots;         // One per narrowphase thread, reused every substep
+    std::vector<uint8_t> bodyShapes;                       // Shape kind of each body, for the test counts
+    std::vector<AABB> sweptBounds;                         // Broadphase bounds swept over the step
+    mutable std::vector<size_t> boundsOrder;               // sweptBounds indices sorted by min x, for region queries
+    mutable float widestBounds{0.0f};                      // Largest width in boundsOrder, oversized bounds aside
+    mutable float oversizedWidth{0.0f};                    // Bounds wider than this are oversized
+    mutable std::vector<size_t> oversizedBounds;           // Few very wide bodies, like floors, tested by every query
+    std::vector<AABB> settledBounds;                       // Bounds where each body ended the last step
+    float boundsDrift{0.0f};                               // Furthest a settled bound lies outside its swept bound
+    std::vector<glm::vec2> startPositions;                 // Positions before the last integration
+    std::vector<float> startRotations;                     // Rotations before the last integration
+    std::vector<float> impactTimes;                        // Earliest time of impact per bullet
+    std::vector<size_t> impactTargets;                     // Body hit at that time of impact
+    std::vector<glm::vec2> impactNormals;                  // Normal from the target to the bullet
+    std::vector<glm::vec2> sweepVertices;                  // Target outline for circle sweeps
     glm::vec2 gravity{0.0f, -9.81f};
     float drag{0.01f};
     float windowWidth{2.0f};  // OpenGL coordinates (-1 to 1)
     float windowHeight{2.0f}; // OpenGL coordinates (-1 to 1)
+    int substeps{1};          // Number of substeps each update is split into
+    int solverIterations{1};  // Resolution passes over the contacts per substep
+    float substepTime{0.0f};  // Duration of the substep being simulated
+    bool speculativeContactsEnabled{false};
+    size_t axisCacheQueries{0}; // Narrowphase queries that had a cached axis to try
+    size_t axisCacheHits{0};    // Queries the cached axis rejected on its own
+    BroadphaseMode broadphaseMode{BroadphaseMode::SweepAndPrune};
+    int threadCount{1};         // Threads the narrowphase is split across
+    WorkerPool workerPool;      // threadCount - 1 persistent helpers; the updating thread is the first
+    PhaseTimings timings;
+    DebugDraw debugDraw;        // Filled during update() when built with COLLISION_DEBUG_DRAW
+    PipelineStats stats;        // Counts of the last update()
+
+    // Capacity of each reusable scratch buffer, to count the ones a step grew.
+    // Fixed length, so taking them allocates nothing itself.
+    static const size_t SCRATCH_BUFFERS = 19;
+    using ScratchCapacities = std::array<size_t, SCRATCH_BUFFERS>;
+    ScratchCapacities capacitiesBefore{};  // Taken at the start of update()
+    void scratchCapacities(ScratchCapacities& capacities) const;
+
+    // Record where bodies ended the step. Bounces, position correction and
+    // rotation can carry a body outside its swept bounds.
+    void settleBounds();
+
+    // Broadphase strategies, each appending overlapping pairs of sweptBounds
+    void findPairsBruteForce();
+    void findPairsSweepAndPrune();
+    void findPairsUniformGrid();
+    void addCandidatePair(size_t a, size_t b);
+    void sortBoundsOrder() const;
+
+    // Push a touching pair apart by its penetration depth, split by inverse mass
+    void correctPositions(PhysicsObject& obj1, PhysicsObject& obj2, const ContactManifold& manifold);
+
+    // Pull bullets back to their first time of impact along the last integration
+    void sweepBullets();
+
+    // Remove only the approach speed that would overshoot the gap this substep
+    void applySpeculativeImpulse(PhysicsObject& obj1, PhysicsObject& obj2, const SpeculativeContact& contact);
+
+    // Restitution impulse along a normal pointing from obj2 to obj1
+    void applyImpactImpulse(PhysicsObject& obj1, PhysicsObject& obj2, const glm::vec2& normal);
 
 public:
     PhysicsWorld(float width = 2.0f, float height = 2.0f)
@@ -21,17 +156,67 @@ public:
         objects.push_back(obj);
     }
 
+    // Size of the walled area, centered on the origin
+    float getWidth() const { return windowWidth; }
+    float getHeight() const { return windowHeight; }
+
     void setGravity(const glm::vec2& g) { gravity = g; }
     void setDrag(float d) { drag = d; }
-    
+
+    // Split each update into n substeps; the broadphase still runs once per update
+    void setSubsteps(int n) { substeps = n > 0 ? n : 1; }
+    int getSubsteps() const { return substeps; }
+    void setSolverIterations(int n) { solverIterations = n > 0 ? n : 1; }
+    int getSolverIterations() const { return solverIterations; }
+
+    // Create contacts for separated pairs that are closing fast enough to
+    // meet within a substep, so they stop at the surface without CCD
+    void setSpeculativeContactsEnabled(bool enabled) { speculativeContactsEnabled = enabled; }
+    bool getSpeculativeContactsEnabled() const { return speculativeContactsEnabled; }
+
+    void setBroadphaseMode(BroadphaseMode mode) { broadphaseMode = mode; }
+    BroadphaseMode getBroadphaseMode() const { return broadphaseMode; }
+
+    // Split narrowphase detection across n threads; contacts come out in the same order
+    void setThreadCount(int n);
+    int getThreadCount() const { return threadCount; }
+
+    const PhaseTimings& getTimings() const { return timings; }
+    void resetTimings() { timings = PhaseTimings(); }
+
+    // Where the last step's work went: bodies, pairs, tests by shape, contacts
+    const PipelineStats& getStats() const { return stats; }
+
+    // Separating-axis cache effectiveness, accumulated until reset
+    size_t getAxisCacheQueries() const { return axisCacheQueries; }
+    size_t getAxisCacheHits() const { return axisCacheHits; }
+    float getAxisCacheHitRate() const {
+        return axisCacheQueries > 0 ? static_cast<float>(axisCacheHits) / axisCacheQueries : 0.0f;
+    }
+    void resetAxisCacheStats() { axisCacheQueries = 0; axisCacheHits = 0; }
+
+    // Debug geometry from the last update; empty unless built with COLLISION_DEBUG_DRAW
+    const DebugDraw& getDebugDraw() const { return debugDraw; }
+
     const std::vector<std::shared_ptr<PhysicsObject>>& getObjects() const { return objects; }
-    
+    const std::vector<std::pair<size_t, size_t>>& getCandidatePairs() const { return candidatePairs; }
+    const std::vector<Contact>& getContacts() const { return contacts; }
+    const std::vector<SpeculativeContact>& getSpeculativeContacts() const { return speculativeContacts; }
+
     void update(float deltaTime);
+    void findCandidatePairs(float deltaTime);
     void checkCollisions();
-    void draw() const;
+    void resolveCollisions();
     void applyForces(float deltaTime);
     void checkBoundaries();
-    
+    void integrate(float deltaTime);
+
+    // Append the indices of objects whose bounds overlap a region, in index
+    // order. Uses the last broadphase order and the bounds each body ended
+    // the step with, so cost follows the bodies near the region plus the few
+    // far wider than average, rather than the size of the world.
+    void queryRegion(const AABB& region, std::vector<size_t>& result) const;
+
     // Find object at position (for mouse interaction)
     std::shared_ptr<PhysicsObject> findObjectAtPosition(const glm::vec2& pos);
 };
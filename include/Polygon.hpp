@@ -1,38 +1,53 @@
 #pragma once
 #include "PhysicsObject.hpp"
-#include "Renderer.hpp"
+#include "Manifold.hpp"
 #include <vector>
+#include <atomic>
+
+class Circle;
 
 class Polygon : public PhysicsObject {
 private:
     std::vector<glm::vec2> vertices;  // Local space vertices
+    std::vector<glm::vec2> hull;      // Counter-clockwise convex hull of the vertices
+    std::vector<glm::vec2> normals;   // Local space outward unit normals of the hull edges
+    mutable std::atomic<size_t> supportHint{0}; // Hull index the last support search ended on
+    float boundingRadius;             // Distance to the farthest vertex
     glm::vec3 color;
 
-    // Helper method for polygon-polygon collision detection using SAT
-    bool checkPolygonPolygonCollision(const std::vector<glm::vec2>& vertsA, 
-                                    const std::vector<glm::vec2>& vertsB) const;
+    // Precompute the hull, its edge normals and the bounding radius from the vertices
+    void computeShapeData();
+
+    // SAT against a polygon or rectangle using support points only, keeping the minimum penetration face
+    bool collideConvex(const PhysicsObject& other, ContactManifold& manifold,
+                       SeparatingAxisCache* cache) const;
 
 public:
     Polygon(const glm::vec2& pos, const std::vector<glm::vec2>& verts, float m = 1.0f)
         : PhysicsObject(pos, m)
         , vertices(verts)
+        , boundingRadius(0.0f)
         , color(1.0f, 1.0f, 1.0f)  // Default white color
-    {}
+    {
+        computeShapeData();
+    }
 
     void setColor(const glm::vec3& c) { color = c; }
     const glm::vec3& getColor() const { return color; }
     const std::vector<glm::vec2>& getLocalVertices() const { return vertices; }
+    const std::vector<glm::vec2>& getHull() const { return hull; }
+    const std::vector<glm::vec2>& getLocalNormals() const { return normals; }
 
     // Get vertices in world space (transformed by position and rotation)
     std::vector<glm::vec2> getWorldVertices() const;
+    void getWorldVertices(std::vector<glm::vec2>& out) const; // Reuses out's storage
 
-    bool checkCollision(const PhysicsObject& other) const override;
-    void resolveCollision(PhysicsObject& other);
-    
-    void draw() const override {
-        Renderer::drawPolygon(position, vertices, rotation, color);
-        if (showVelocityVectors) {
-            Renderer::drawVelocityVector(position, velocity * 0.1f);
-        }
-    }
+    bool collide(const PhysicsObject& other, ContactManifold& manifold,
+                 SeparatingAxisCache* cache = nullptr) const override;
+
+    // Voronoi-region circle test; the manifold normal points from the polygon to the circle
+    bool collideCircle(const Circle& circle, ContactManifold& manifold) const;
+    AABB getBounds() const override;
+    float getBoundingRadius() const override { return boundingRadius; }
+    glm::vec2 getSupportPoint(const glm::vec2& localDirection) const override;
 };
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One timed scope recorded by a thread
+struct ProfileZone {
+    const char* name; // String literal given to PROFILE_ZONE
+    uint64_t frame;   // Profiler frame the zone started in
+    uint64_t startNs; // steady_clock time in nanoseconds
+    uint64_t endNs;
+    uint32_t thread;  // Track of the recording thread, never shared with another thread
+    uint32_t depth;   // Nesting level on that thread
+};
+
+// Lightweight instrumentation: scoped zones write into a fixed ring buffer
+// owned by the recording thread, so recording never takes a lock. Rings of
+// exited threads are handed to the next new thread to bound memory, but every
+// thread gets a fresh track number, so one track never mixes two threads.
+// Long-lived threads such as the narrowphase workers keep theirs for life.
+//
+// Zones are read back per frame with collectFrame(), from the thread that
+// drives the updates and between them, when no other thread is recording.
+class Profiler {
+public:
+    static const size_t RING_CAPACITY = 4096; // Zones kept per thread
+
+    static uint64_t now(); // Nanoseconds on the steady clock
+
+    // Start a new frame; PhysicsWorld::update calls this once per step
+    static void beginFrame();
+    static uint64_t getFrame();
+
+    // Track of the calling thread, as found in ProfileZone::thread
+    static uint32_t getThreadIndex();
+
+    // Label the calling thread's track; empty for tracks never named
+    static void setThreadName(const std::string& name);
+    static std::string getThreadName(uint32_t thread);
+
+    // Append every zone still held for a frame, ordered by thread and start time
+    static void collectFrame(uint64_t frame, std::vector<ProfileZone>& zones);
+
+    // Calling thread's track and nesting bookkeeping, used by ProfileScope
+    static uint32_t enterZone(uint32_t& depth);
+    static void leaveZone(const ProfileZone& zone);
+};
+
+// Times the enclosing scope
+class ProfileScope {
+private:
+    ProfileZone zone;
+
+public:
+    explicit ProfileScope(const char* name) {
+        zone.name = name;
+        zone.frame = Profiler::getFrame();
+        zone.thread = Profiler::enterZone(zone.depth);
+        zone.startNs = Profiler::now();
+    }
+
+    ~ProfileScope() {
+        zone.endNs = Profiler::now();
+        Profiler::leaveZone(zone);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+// Zones are compiled in unless COLLISION_DISABLE_PROFILING is defined
+#ifdef COLLISION_DISABLE_PROFILING
+#define PROFILE_ZONE(name)
+#define PROFILE_FRAME()
+#define PROFILE_THREAD_NAME(name)
+#else
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::beginFrame()
+#define PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+#endif
@@ -1,13 +1,14 @@
 #pragma once
 #include "PhysicsObject.hpp"
-#include "Renderer.hpp"
+#include "Manifold.hpp"
 #include <vector>
+#include <cmath>
 
 class Rectangle : public PhysicsObject {
 private:
     float width;
     float height;
-    float rotation; // in radians
+    float boundingRadius; // Half the diagonal
     glm::vec3 color;
 
 public:
@@ -15,27 +16,29 @@ public:
         : PhysicsObject(pos, m)
         , width(w)
         , height(h)
-        , rotation(0.0f)
+        , boundingRadius(0.5f * std::sqrt(w * w + h * h))
         , color(1.0f, 1.0f, 1.0f)  // Default white color
     {}
 
     float getWidth() const { return width; }
     float getHeight() const { return height; }
-    float getRotation() const { return rotation; }
-    void setRotation(float r) { rotation = r; }
     void setColor(const glm::vec3& c) { color = c; }
     const glm::vec3& getColor() const { return color; }
 
     // Get vertices in world space
     std::vector<glm::vec2> getVertices() const;
+    void getVertices(std::vector<glm::vec2>& out) const; // Reuses out's storage
 
-    bool checkCollision(const PhysicsObject& other) const override;
-    void resolveCollision(PhysicsObject& other);
-    
-    void draw() const override {
-        Renderer::drawRectangle(position, width, height, rotation, color);
-        if (showVelocityVectors) {
-            Renderer::drawVelocityVector(position, velocity * 0.1f);
-        }
+    bool collide(const PhysicsObject& other, ContactManifold& manifold,
+                 SeparatingAxisCache* cache = nullptr) const override;
+
+    // Oriented box test on the four face axes; the manifold normal points from this box to the other
+    bool collideRectangle(const Rectangle& other, ContactManifold& manifold,
+                          SeparatingAxisCache* cache = nullptr) const;
+    AABB getBounds() const override;
+    float getBoundingRadius() const override { return boundingRadius; }
+    glm::vec2 getSupportPoint(const glm::vec2& localDirection) const override {
+        return glm::vec2(localDirection.x >= 0.0f ? width / 2.0f : -width / 2.0f,
+                         localDirection.y >= 0.0f ? height / 2.0f : -height / 2.0f);
     }
 };
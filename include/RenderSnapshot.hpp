@@ -0,0 +1,42 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include "PhysicsWorld.hpp"
+#include "DebugDraw.hpp"
+
+enum class SnapshotShape {
+    Circle,
+    Rectangle,
+    Polygon
+};
+
+// Everything needed to draw one body, copied out of the simulation
+struct SnapshotBody {
+    SnapshotShape shape;
+    glm::vec2 position;
+    glm::vec2 rotor;         // Cached (cos, sin) of the rotation
+    glm::vec2 size;          // Radius in x for circles, width and height for rectangles
+    glm::vec3 color;
+    glm::vec2 velocity;
+    uint32_t firstVertex{0}; // Polygons: local vertices in RenderSnapshot::polygonVertices
+    uint32_t vertexCount{0};
+};
+
+// Immutable view of a world at one step, handed from the physics thread to
+// the render thread so drawing never touches live bodies
+struct RenderSnapshot {
+    std::vector<SnapshotBody> bodies;
+    std::vector<glm::vec2> polygonVertices;
+    bool showVelocityVectors{false};
+    uint64_t step{0};
+    size_t totalBodies{0};       // Bodies in the world, including ones outside the view
+    size_t candidatePairs{0};    // Broadphase pairs of the step
+    size_t contacts{0};          // Touching pairs from the last substep
+    PhaseTimings timings;        // The world's accumulated phase timings at this step
+    std::vector<size_t> visible; // Scratch list of bodies overlapping the view
+    DebugDraw debugDraw;         // Debug geometry from the step, empty unless compiled in
+
+    // Refill from the bodies that overlap the view, reusing the existing storage
+    void capture(const PhysicsWorld& world, uint64_t stepIndex, const AABB& view);
+};
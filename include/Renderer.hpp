@@ -2,79 +2,227 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
+struct AABB;
+class PhysicsObject;
+class PhysicsWorld;
+class DebugDraw;
+struct RenderSnapshot;
+
+// Interleaved vertex as submitted to OpenGL
+struct RenderVertex {
+    glm::vec2 position;
+    glm::vec3 color;
+};
+
+// Per-circle instance data: center, radius and color, six floats
+struct CircleInstance {
+    glm::vec2 center;
+    float radius;
+    glm::vec3 color;
+};
+
+// Shapes are not drawn immediately: each draw call appends world-space
+// vertices to a CPU-side buffer, and flush() submits every buffer with a
+// single glDrawArrays per primitive type. Circles are recorded as
+// instances and expanded from a shared unit mesh when the frame is flushed.
+// Only OpenGL 1.1 client vertex arrays are used, so it runs on any context
+// including Mesa's software rasterizer.
+//
+// Tessellation follows on-screen size: circles and polygons get just enough
+// segments to keep the outline within half a pixel, and bodies smaller than
+// a pixel are drawn as single points.
 class Renderer {
-public:
-    static void drawCircle(const glm::vec2& center, float radius, const glm::vec3& color = glm::vec3(1.0f)) {
-        const int segments = 32;
-        glBegin(GL_TRIANGLE_FAN);
-        glColor3f(color.x, color.y, color.z);
-        glVertex2f(center.x, center.y);
-        for (int i = 0; i <= segments; i++) {
-            float angle = 2.0f * 3.14159f * float(i) / float(segments);
-            glVertex2f(center.x + radius * cosf(angle), 
-                      center.y + radius * sinf(angle));
+private:
+    // Segment counts of the shared unit-circle meshes
+    static const int LOD_LEVELS = 8;
+    static constexpr int LOD_SEGMENTS[LOD_LEVELS] = {6, 8, 12, 16, 24, 32, 48, 64};
+    static constexpr float LOD_TOLERANCE = 0.5f; // Largest outline error in pixels
+
+    inline static float pixelsPerUnit = 300.0f;
+
+    inline static std::vector<RenderVertex> triangles;
+    inline static std::vector<RenderVertex> lines;
+    inline static std::vector<RenderVertex> points;
+    inline static std::vector<RenderVertex> bodyPoints;                 // Sub-pixel bodies
+    inline static std::vector<CircleInstance> circles[LOD_LEVELS];      // Instances per mesh level
+    inline static std::vector<RenderVertex> circleVertices;             // Circle instances expanded at flush
+
+    // Segments needed to keep a circle's chords within the tolerance
+    static int segmentsForRadius(float radiusPixels) {
+        if (radiusPixels <= LOD_TOLERANCE) return LOD_SEGMENTS[0];
+        return static_cast<int>(std::ceil(3.14159f / std::acos(1.0f - LOD_TOLERANCE / radiusPixels)));
+    }
+
+    static int lodLevel(float radiusPixels) {
+        int segments = segmentsForRadius(radiusPixels);
+        for (int level = 0; level < LOD_LEVELS; level++) {
+            if (LOD_SEGMENTS[level] >= segments) return level;
         }
-        glEnd();
+        return LOD_LEVELS - 1;
     }
 
-    static void drawRectangle(const glm::vec2& center, float width, float height, 
-                            float rotation, const glm::vec3& color = glm::vec3(1.0f)) {
-        glPushMatrix();
-        glTranslatef(center.x, center.y, 0.0f);
-        glRotatef(rotation * 57.2958f, 0.0f, 0.0f, 1.0f); // Convert radians to degrees
+    // Unit-circle triangle list for a mesh level, computed once and shared by every circle
+    static const std::vector<glm::vec2>& unitCircleMesh(int level) {
+        static const std::vector<std::vector<glm::vec2>> meshes = [] {
+            std::vector<std::vector<glm::vec2>> all(LOD_LEVELS);
+            for (int level = 0; level < LOD_LEVELS; level++) {
+                int segments = LOD_SEGMENTS[level];
+                for (int i = 0; i < segments; i++) {
+                    float angle1 = 2.0f * 3.14159f * float(i) / float(segments);
+                    float angle2 = 2.0f * 3.14159f * float(i + 1) / float(segments);
+                    all[level].push_back(glm::vec2(0.0f));
+                    all[level].push_back(glm::vec2(std::cos(angle1), std::sin(angle1)));
+                    all[level].push_back(glm::vec2(std::cos(angle2), std::sin(angle2)));
+                }
+            }
+            return all;
+        }();
+        return meshes[level];
+    }
 
-        glBegin(GL_QUADS);
-        glColor3f(color.x, color.y, color.z);
-        glVertex2f(-width/2, -height/2);
-        glVertex2f(width/2, -height/2);
-        glVertex2f(width/2, height/2);
-        glVertex2f(-width/2, height/2);
-        glEnd();
+    // Place the shared meshes at every circle instance in one pass
+    static void expandCircles() {
+        size_t total = 0;
+        for (int level = 0; level < LOD_LEVELS; level++) {
+            total += circles[level].size() * unitCircleMesh(level).size();
+        }
+        circleVertices.resize(total);
 
-        glPopMatrix();
+        RenderVertex* out = circleVertices.data();
+        for (int level = 0; level < LOD_LEVELS; level++) {
+            const auto& mesh = unitCircleMesh(level);
+            for (const auto& circle : circles[level]) {
+                for (const auto& v : mesh) {
+                    out->position = circle.center + v * circle.radius;
+                    out->color = circle.color;
+                    out++;
+                }
+            }
+        }
     }
 
-    static void drawCollisionPoint(const glm::vec2& point) {
+    // Bodies under a pixel across collapse to a point
+    static bool drawAsPoint(const glm::vec2& center, float radius, const glm::vec3& color) {
+        if (radius * pixelsPerUnit * 2.0f >= 1.0f) return false;
+        bodyPoints.push_back({center, color});
+        return true;
+    }
+
+    static glm::vec2 rotate(const glm::vec2& v, const glm::vec2& rotor) {
+        return glm::vec2(v.x * rotor.x - v.y * rotor.y, v.x * rotor.y + v.y * rotor.x);
+    }
+
+    static void submit(const std::vector<RenderVertex>& vertices, GLenum mode) {
+        if (vertices.empty()) return;
+        glVertexPointer(2, GL_FLOAT, sizeof(RenderVertex), &vertices[0].position);
+        glColorPointer(3, GL_FLOAT, sizeof(RenderVertex), &vertices[0].color);
+        glDrawArrays(mode, 0, static_cast<GLsizei>(vertices.size()));
+    }
+
+public:
+    // Start collecting a new frame
+    static void beginFrame() {
+        triangles.clear();
+        lines.clear();
+        points.clear();
+        bodyPoints.clear();
+        for (auto& level : circles) level.clear();
+    }
+
+    // Screen scale used to pick the level of detail
+    static void setPixelsPerUnit(float pixels) { pixelsPerUnit = pixels; }
+    static float getPixelsPerUnit() { return pixelsPerUnit; }
+
+    // Submit everything collected since beginFrame()
+    static void flush() {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+
+        submit(triangles, GL_TRIANGLES);
+        expandCircles();
+        submit(circleVertices, GL_TRIANGLES);
+        submit(lines, GL_LINES);
+        glPointSize(1.0f);
+        submit(bodyPoints, GL_POINTS);
         glPointSize(5.0f);
-        glBegin(GL_POINTS);
-        glColor3f(1.0f, 0.0f, 0.0f);  // Red color for collision points
-        glVertex2f(point.x, point.y);
-        glEnd();
+        submit(points, GL_POINTS);
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
     }
 
-    static void drawVelocityVector(const glm::vec2& start, const glm::vec2& velocity, 
+    // Draw a body by dispatching on its shape, plus its velocity vector if enabled
+    static void drawObject(const PhysicsObject& object);
+
+    // One full frame: every body overlapping the view, batched and flushed
+    static void drawWorld(const PhysicsWorld& world, const AABB& view);
+
+    // One full frame from a snapshot published by the physics thread
+    static void drawSnapshot(const RenderSnapshot& snapshot);
+
+    // Add debug geometry to the frame's line and point batches
+    static void drawDebug(const DebugDraw& debug);
+
+    static void drawCircle(const glm::vec2& center, float radius, const glm::vec3& color = glm::vec3(1.0f)) {
+        if (drawAsPoint(center, radius, color)) return;
+        circles[lodLevel(radius * pixelsPerUnit)].push_back({center, radius, color});
+    }
+
+    // rotor is the body's cached (cos, sin) of its rotation
+    static void drawRectangle(const glm::vec2& center, float width, float height,
+                            const glm::vec2& rotor, const glm::vec3& color = glm::vec3(1.0f)) {
+        if (drawAsPoint(center, 0.5f * std::sqrt(width * width + height * height), color)) return;
+
+        glm::vec2 corners[4] = {
+            center + rotate(glm::vec2(-width/2, -height/2), rotor),
+            center + rotate(glm::vec2(width/2, -height/2), rotor),
+            center + rotate(glm::vec2(width/2, height/2), rotor),
+            center + rotate(glm::vec2(-width/2, height/2), rotor)
+        };
+        for (int i : {0, 1, 2, 0, 2, 3}) {
+            triangles.push_back({corners[i], color});
+        }
+    }
+
+    static void drawCollisionPoint(const glm::vec2& point) {
+        points.push_back({point, glm::vec3(1.0f, 0.0f, 0.0f)});  // Red color for collision points
+    }
+
+    static void drawVelocityVector(const glm::vec2& start, const glm::vec2& velocity,
                                  const glm::vec3& color = glm::vec3(0.0f, 1.0f, 0.0f)) {
-        glm::vec2 end = start + velocity;
-        glBegin(GL_LINES);
-        glColor3f(color.x, color.y, color.z);
-        glVertex2f(start.x, start.y);
-        glVertex2f(end.x, end.y);
-        glEnd();
-    }
-
-    static void drawPolygon(const glm::vec2& center, const std::vector<glm::vec2>& vertices,
-                           float rotation, const glm::vec3& color = glm::vec3(1.0f)) {
-        glPushMatrix();
-        glTranslatef(center.x, center.y, 0.0f);
-        glRotatef(rotation * 57.2958f, 0.0f, 0.0f, 1.0f); // Convert radians to degrees
-
-        glBegin(GL_TRIANGLE_FAN);
-        glColor3f(color.x, color.y, color.z);
-        
-        // Start from center
-        glVertex2f(0.0f, 0.0f);
-        
-        // Draw vertices
-        for (const auto& vertex : vertices) {
-            glVertex2f(vertex.x, vertex.y);
+        drawLine(start, start + velocity, color);
+    }
+
+    static void drawLine(const glm::vec2& from, const glm::vec2& to, const glm::vec3& color) {
+        lines.push_back({from, color});
+        lines.push_back({to, color});
+    }
+
+    // Axis-aligned filled box with no level of detail, for overlays
+    static void drawBox(const glm::vec2& min, const glm::vec2& max, const glm::vec3& color) {
+        glm::vec2 corners[4] = {min, glm::vec2(max.x, min.y), max, glm::vec2(min.x, max.y)};
+        for (int i : {0, 1, 2, 0, 2, 3}) {
+            triangles.push_back({corners[i], color});
         }
-        // Close the polygon by connecting back to the first vertex
-        if (!vertices.empty()) {
-            glVertex2f(vertices[0].x, vertices[0].y);
+    }
+
+    // radius is the distance from the center to the farthest vertex
+    static void drawPolygon(const glm::vec2& center, const glm::vec2* vertices, size_t count, float radius,
+                           const glm::vec2& rotor, const glm::vec3& color = glm::vec3(1.0f)) {
+        if (count == 0 || drawAsPoint(center, radius, color)) return;
+
+        // Skip vertices when there are more than a circle of this size would need
+        size_t stride = std::max<size_t>(1, count / segmentsForRadius(radius * pixelsPerUnit));
+
+        // Fan from the center, closed back to the first vertex
+        for (size_t i = 0; i < count; i += stride) {
+            size_t next = i + stride < count ? i + stride : 0;
+            triangles.push_back({center, color});
+            triangles.push_back({center + rotate(vertices[i], rotor), color});
+            triangles.push_back({center + rotate(vertices[next], rotor), color});
         }
-        
-        glEnd();
-        glPopMatrix();
     }
 };
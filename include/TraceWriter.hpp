@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Profiler.hpp"
+
+class PhysicsWorld;
+
+// Streams profiling zones to a Chrome trace-event JSON file, which opens in
+// chrome://tracing and the Perfetto UI. Every frame is written as soon as it
+// is handed over, so memory stays flat however long the capture runs. Each
+// profiler thread gets its own named track.
+class TraceWriter {
+private:
+    std::ofstream out;
+    uint64_t originNs{0};             // Timestamps are written relative to open()
+    bool firstEvent{true};
+    uint32_t writerThread{0};         // Track of the thread that calls writeFrame
+    std::vector<bool> namedThreads;   // Tracks that already have a thread_name record
+    std::vector<ProfileZone> zones;   // Scratch list reused for every frame
+
+    void beginEvent();
+    void nameThread(uint32_t thread);
+    double toMicroseconds(uint64_t ns) const;
+
+public:
+    TraceWriter() = default;
+    ~TraceWriter(); // Closes the file if still open
+
+    // Start a trace file; prints the reason and returns false on failure
+    bool open(const std::string& path);
+    bool isOpen() const { return out.is_open(); }
+
+    // Write every zone recorded in a profiler frame
+    void writeFrame(uint64_t frame);
+
+    // Counter track sample at the current time
+    void writeCounter(const char* name, double value);
+
+    // Body, pair, test, contact and allocation counts of the world's last step, as counter tracks
+    void writeWorldCounters(const PhysicsWorld& world);
+
+    // Finish the JSON and close the file
+    void close();
+};
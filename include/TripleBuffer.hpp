@@ -0,0 +1,33 @@
+#pragma once
+#include <atomic>
+
+// Single-producer, single-consumer triple buffer. The writer fills
+// writeBuffer() and publishes it; the reader picks up the newest published
+// buffer with update(). Neither side ever waits: each owns one slot, and the
+// third is handed back and forth with a single atomic exchange.
+template <typename T>
+class TripleBuffer {
+private:
+    static const int INDEX_MASK = 3;
+    static const int DIRTY = 4; // Set while the shared slot holds an unread publish
+
+    T slots[3];
+    std::atomic<int> shared{1};
+    int back{0};  // Slot owned by the writer
+    int front{2}; // Slot owned by the reader
+
+public:
+    // Writer side
+    T& writeBuffer() { return slots[back]; }
+    void publish() {
+        back = shared.exchange(back | DIRTY, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader side: swap in the newest published buffer, if any
+    bool update() {
+        if (!(shared.load(std::memory_order_relaxed) & DIRTY)) return false;
+        front = shared.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return slots[front]; }
+};
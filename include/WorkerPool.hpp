@@ -0,0 +1,41 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that stay alive between jobs, so splitting work
+// across threads costs a wake-up rather than a thread start and join.
+// Worker i always runs slice i + 1 of a job; the calling thread runs slice 0.
+class WorkerPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workReady;
+    std::condition_variable workDone;
+    const std::function<void(size_t)>* job{nullptr};
+    size_t activeSlices{0};
+    size_t remaining{0};     // Worker slices of the current job still running
+    uint64_t generation{0};  // Bumped for every job so each worker takes it once
+    bool stopping{false};
+
+    void workerLoop(size_t index, uint64_t seen);
+    void stop();
+
+public:
+    WorkerPool() = default;
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Stop the current workers and start count new ones
+    void resize(size_t count);
+    size_t size() const { return workers.size(); }
+
+    // Run job(slice) for every slice below slices and wait for all of them.
+    // Slices beyond the worker count plus one are not run.
+    void run(size_t slices, const std::function<void(size_t)>& job);
+};
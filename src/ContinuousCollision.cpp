@@ -0,0 +1,266 @@
+#include "../include/ContinuousCollision.hpp"
+#include "../include/Circle.hpp"
+#include "../include/Rectangle.hpp"
+#include "../include/Polygon.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+bool ContinuousCollision::rayCircle(const glm::vec2& start, const glm::vec2& dir,
+                                    const glm::vec2& center, float radius, float& t) {
+    glm::vec2 m = start - center;
+    float c = glm::dot(m, m) - radius * radius;
+
+    // Starting inside counts as an immediate hit
+    if (c <= 0.0f) {
+        t = 0.0f;
+        return true;
+    }
+
+    float a = glm::dot(dir, dir);
+    if (a < 1e-12f) return false;
+
+    float b = glm::dot(m, dir);
+    if (b >= 0.0f) return false; // Moving away
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return false;
+
+    t = (-b - std::sqrt(discriminant)) / a;
+    return t <= 1.0f;
+}
+
+bool ContinuousCollision::rayBox(const glm::vec2& start, const glm::vec2& dir,
+                                 const glm::vec2& extent, float& t) {
+    float tEnter = 0.0f;
+    float tLeave = 1.0f;
+
+    for (int axis = 0; axis < 2; axis++) {
+        if (std::abs(dir[axis]) < 1e-12f) {
+            // Parallel to the slab: must already be within it
+            if (start[axis] < -extent[axis] || start[axis] > extent[axis]) return false;
+            continue;
+        }
+
+        float t1 = (-extent[axis] - start[axis]) / dir[axis];
+        float t2 = (extent[axis] - start[axis]) / dir[axis];
+        if (t1 > t2) std::swap(t1, t2);
+
+        tEnter = std::max(tEnter, t1);
+        tLeave = std::min(tLeave, t2);
+        if (tEnter > tLeave) return false;
+    }
+
+    t = tEnter;
+    return true;
+}
+
+bool ContinuousCollision::rayConvexPolygon(const glm::vec2& start, const glm::vec2& dir,
+                                           const glm::vec2* verts, size_t count, float winding, float& t) {
+    float tEnter = 0.0f;
+    float tLeave = 1.0f;
+
+    for (size_t i = 0; i < count; i++) {
+        glm::vec2 edge = verts[(i + 1) % count] - verts[i];
+        glm::vec2 normal = glm::vec2(edge.y, -edge.x) * winding; // Outward, not normalized
+
+        float numerator = glm::dot(normal, verts[i] - start);
+        float denominator = glm::dot(normal, dir);
+
+        if (std::abs(denominator) < 1e-12f) {
+            // Parallel to this edge and outside of it
+            if (numerator < 0.0f) return false;
+            continue;
+        }
+
+        float edgeT = numerator / denominator;
+        if (denominator < 0.0f) {
+            tEnter = std::max(tEnter, edgeT);
+        } else {
+            tLeave = std::min(tLeave, edgeT);
+        }
+        if (tEnter > tLeave) return false;
+    }
+
+    t = tEnter;
+    return true;
+}
+
+glm::vec2 ContinuousCollision::closestPointOnBoundary(const glm::vec2& p, const std::vector<glm::vec2>& verts) {
+    glm::vec2 closest = verts[0];
+    float bestDistSq = INFINITY;
+
+    for (size_t i = 0; i < verts.size(); i++) {
+        const glm::vec2& v1 = verts[i];
+        const glm::vec2& v2 = verts[(i + 1) % verts.size()];
+        glm::vec2 edge = v2 - v1;
+        float edgeLengthSq = glm::dot(edge, edge);
+        float s = edgeLengthSq > 0.0f ? glm::dot(p - v1, edge) / edgeLengthSq : 0.0f;
+        glm::vec2 candidate = v1 + edge * std::max(0.0f, std::min(1.0f, s));
+
+        glm::vec2 diff = p - candidate;
+        float distSq = glm::dot(diff, diff);
+        if (distSq < bestDistSq) {
+            bestDistSq = distSq;
+            closest = candidate;
+        }
+    }
+
+    return closest;
+}
+
+TimeOfImpact ContinuousCollision::sweepCircle(const glm::vec2& start, const glm::vec2& displacement,
+                                              float radius, const PhysicsObject& target,
+                                              std::vector<glm::vec2>& verts) {
+    TimeOfImpact result;
+    float t = 1.0f;
+    bool hit = false;
+
+    // Keep the earliest entry over all pieces of the swept target
+    float pieceT = 1.0f;
+    auto consider = [&]() {
+        if (pieceT < t) {
+            t = pieceT;
+            hit = true;
+        }
+    };
+
+    if (auto circle = dynamic_cast<const Circle*>(&target)) {
+        // Swept circle against circle reduces to a ray against the summed radius
+        if (rayCircle(start, displacement, circle->getPosition(),
+                      radius + circle->getRadius(), pieceT)) {
+            consider();
+        }
+
+        if (!hit || t <= 0.0f) return result;
+
+        glm::vec2 center = start + displacement * t;
+        result.normal = glm::normalize(center - circle->getPosition());
+        result.point = circle->getPosition() + result.normal * circle->getRadius();
+        result.hit = true;
+        result.time = t;
+        return result;
+    }
+    else if (auto rect = dynamic_cast<const Rectangle*>(&target)) {
+        // Work in the rectangle's local space, where it is an axis-aligned box
+        glm::vec2 localStart = rect->rotateToLocal(start - rect->getPosition());
+        glm::vec2 localDir = rect->rotateToLocal(displacement);
+        glm::vec2 halfSize(rect->getWidth() / 2.0f, rect->getHeight() / 2.0f);
+
+        // The rounded box is the union of two slabs and four corner circles
+        if (rayBox(localStart, localDir, halfSize + glm::vec2(radius, 0.0f), pieceT)) consider();
+        if (rayBox(localStart, localDir, halfSize + glm::vec2(0.0f, radius), pieceT)) consider();
+        for (int i = 0; i < 4; i++) {
+            glm::vec2 corner(i & 1 ? halfSize.x : -halfSize.x, i & 2 ? halfSize.y : -halfSize.y);
+            if (rayCircle(localStart, localDir, corner, radius, pieceT)) consider();
+        }
+
+        if (!hit || t <= 0.0f) return result;
+        rect->getVertices(verts);
+    }
+    else if (auto poly = dynamic_cast<const Polygon*>(&target)) {
+        poly->getWorldVertices(verts);
+        if (verts.size() < 3) return result;
+
+        // Orient edge normals outward regardless of the vertex order
+        float area = 0.0f;
+        for (size_t i = 0; i < verts.size(); i++) {
+            const glm::vec2& v1 = verts[i];
+            const glm::vec2& v2 = verts[(i + 1) % verts.size()];
+            area += v1.x * v2.y - v2.x * v1.y;
+        }
+        float winding = area >= 0.0f ? 1.0f : -1.0f;
+
+        // The rounded polygon is the union of the polygon, its edges pushed
+        // outward by the radius and a circle around every vertex
+        if (rayConvexPolygon(start, displacement, verts.data(), verts.size(), winding, pieceT)) consider();
+        for (size_t i = 0; i < verts.size(); i++) {
+            const glm::vec2& v1 = verts[i];
+            const glm::vec2& v2 = verts[(i + 1) % verts.size()];
+            glm::vec2 edge = v2 - v1;
+            float edgeLength = glm::length(edge);
+            if (edgeLength < 1e-6f) continue;
+
+            glm::vec2 offset = glm::vec2(edge.y, -edge.x) * winding * (radius / edgeLength);
+            glm::vec2 quad[4] = {v1, v2, v2 + offset, v1 + offset}; // Opposite winding to the polygon
+            if (rayConvexPolygon(start, displacement, quad, 4, -winding, pieceT)) consider();
+            if (rayCircle(start, displacement, v1, radius, pieceT)) consider();
+        }
+
+        if (!hit || t <= 0.0f) return result;
+    }
+    else {
+        return result;
+    }
+
+    // Contact data from the closest feature at the time of impact
+    glm::vec2 center = start + displacement * t;
+    result.point = closestPointOnBoundary(center, verts);
+    glm::vec2 normal = center - result.point;
+    float distance = glm::length(normal);
+    result.normal = distance > 0.0001f ? normal / distance : -glm::normalize(displacement);
+    result.hit = true;
+    result.time = t;
+    return result;
+}
+
+float ContinuousCollision::separation(const PhysicsObject& a, const Pose& poseA,
+                                      const PhysicsObject& b, const Pose& poseB,
+                                      glm::vec2& pointA, glm::vec2& pointB, float& radiusA, float& radiusB) {
+    SupportShape shapeA(a, poseA);
+    SupportShape shapeB(b, poseB);
+    DistanceResult result = GJK::distance(shapeA, shapeB);
+
+    pointA = result.pointA;
+    pointB = result.pointB;
+    radiusA = shapeA.getRadius();
+    radiusB = shapeB.getRadius();
+    return result.distance;
+}
+
+TimeOfImpact ContinuousCollision::conservativeAdvancement(const PhysicsObject& a, const Pose& startA, const Pose& endA,
+                                                          const PhysicsObject& b, const Pose& startB, const Pose& endB) {
+    const float TOLERANCE = 0.001f;
+    const int MAX_ITERATIONS = 32;
+
+    TimeOfImpact result;
+
+    // Upper bound on how fast any point of a can approach any point of b
+    glm::vec2 relativeMotion = (endA.position - startA.position) - (endB.position - startB.position);
+    float motionBound = glm::length(relativeMotion)
+                      + std::abs(endA.rotation - startA.rotation) * a.getBoundingRadius()
+                      + std::abs(endB.rotation - startB.rotation) * b.getBoundingRadius();
+    if (motionBound < 1e-9f) return result;
+
+    auto lerpPose = [](const Pose& from, const Pose& to, float t) {
+        return Pose{from.position + (to.position - from.position) * t,
+                    from.rotation + (to.rotation - from.rotation) * t};
+    };
+
+    float t = 0.0f;
+    for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+        glm::vec2 pointA, pointB;
+        float radiusA, radiusB;
+        Pose poseA = lerpPose(startA, endA, t);
+        Pose poseB = lerpPose(startB, endB, t);
+        float distance = separation(a, poseA, b, poseB, pointA, pointB, radiusA, radiusB);
+
+        // Already overlapping at the start is the narrowphase's job
+        if (distance <= 0.0f && t == 0.0f) return result;
+
+        if (distance <= TOLERANCE) {
+            glm::vec2 normal = pointA - pointB;
+            float length = glm::length(normal);
+            result.normal = length > 1e-6f ? normal / length : glm::normalize(poseA.position - poseB.position);
+            result.point = pointB + result.normal * radiusB;
+            result.time = t;
+            result.hit = true;
+            return result;
+        }
+
+        t += distance / motionBound;
+        if (t > 1.0f) return result;
+    }
+
+    return result;
+}
@@ -0,0 +1,89 @@
+#include "../include/FrameWriter.hpp"
+#include <cstdio>
+#include <iostream>
+
+FrameWriter::FrameWriter(size_t maxPending)
+    : maxPending(maxPending > 0 ? maxPending : 1)
+    , worker(&FrameWriter::run, this)
+{}
+
+FrameWriter::~FrameWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    frameQueued.notify_one();
+    worker.join();
+}
+
+std::vector<uint8_t> FrameWriter::takeBuffer() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (freeBuffers.empty()) return {};
+    std::vector<uint8_t> buffer = std::move(freeBuffers.back());
+    freeBuffers.pop_back();
+    return buffer;
+}
+
+void FrameWriter::submit(const std::string& path, int width, int height, std::vector<uint8_t> pixels) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        frameDone.wait(lock, [this] { return pending.size() < maxPending; });
+        pending.push_back({path, width, height, std::move(pixels)});
+    }
+    frameQueued.notify_one();
+}
+
+void FrameWriter::finish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    frameDone.wait(lock, [this] { return pending.empty(); });
+}
+
+size_t FrameWriter::getFramesWritten() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return framesWritten;
+}
+
+bool FrameWriter::hasFailed() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+void FrameWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        frameQueued.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) return; // Stopping with nothing left to write
+
+        // Write outside the lock; the frame stays queued so finish() waits for it
+        Frame& frame = pending.front();
+        lock.unlock();
+        bool written = writePPM(frame);
+        lock.lock();
+
+        if (written) framesWritten++;
+        else failed = true;
+        freeBuffers.push_back(std::move(frame.pixels));
+        pending.pop_front();
+        frameDone.notify_all();
+    }
+}
+
+bool FrameWriter::writePPM(const Frame& frame) {
+    FILE* file = std::fopen(frame.path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open frame file: " << frame.path << "\n";
+        return false;
+    }
+
+    // PPM stores the top row first, OpenGL reads the bottom row first
+    std::fprintf(file, "P6\n%d %d\n255\n", frame.width, frame.height);
+    size_t rowSize = static_cast<size_t>(frame.width) * 3;
+    bool ok = true;
+    for (int row = frame.height - 1; row >= 0 && ok; row--) {
+        ok = std::fwrite(frame.pixels.data() + row * rowSize, 1, rowSize, file) == rowSize;
+    }
+    ok = std::fclose(file) == 0 && ok;
+
+    if (!ok) std::cerr << "Failed to write frame file: " << frame.path << "\n";
+    return ok;
+}
@@ -0,0 +1,354 @@
+#include "../include/GJK.hpp"
+#include <algorithm>
+#include <cmath>
+
+SupportShape::SupportShape(const PhysicsObject& obj)
+    : shape(&obj)
+    , position(obj.getPosition())
+    , cosA(obj.getRotor().x)
+    , sinA(obj.getRotor().y)
+{}
+
+SupportShape::SupportShape(const PhysicsObject& obj, const Pose& pose)
+    : shape(&obj)
+    , position(pose.position)
+    , cosA(cos(pose.rotation))
+    , sinA(sin(pose.rotation))
+{}
+
+glm::vec2 SupportShape::support(const glm::vec2& direction) const {
+    // Rotate the direction into local space, query, and rotate the result back
+    glm::vec2 localDir(direction.x * cosA + direction.y * sinA,
+                       -direction.x * sinA + direction.y * cosA);
+    glm::vec2 local = shape->getSupportPoint(localDir);
+    return position + glm::vec2(local.x * cosA - local.y * sinA,
+                                local.x * sinA + local.y * cosA);
+}
+
+GJK::SimplexVertex GJK::makeVertex(const SupportShape& a, const SupportShape& b, const glm::vec2& direction) {
+    // Extreme point of B - A along direction
+    SimplexVertex vertex;
+    vertex.a = a.support(-direction);
+    vertex.b = b.support(direction);
+    vertex.w = vertex.b - vertex.a;
+    vertex.u = 1.0f;
+    return vertex;
+}
+
+void GJK::solve2(Simplex& simplex) {
+    glm::vec2 w1 = simplex.v[0].w;
+    glm::vec2 w2 = simplex.v[1].w;
+    glm::vec2 e12 = w2 - w1;
+
+    // Region of w1
+    float d12_2 = -glm::dot(w1, e12);
+    if (d12_2 <= 0.0f) {
+        simplex.v[0].u = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // Region of w2
+    float d12_1 = glm::dot(w2, e12);
+    if (d12_1 <= 0.0f) {
+        simplex.v[0] = simplex.v[1];
+        simplex.v[0].u = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // Interior of the segment
+    float inv = 1.0f / (d12_1 + d12_2);
+    simplex.v[0].u = d12_1 * inv;
+    simplex.v[1].u = d12_2 * inv;
+    simplex.count = 2;
+}
+
+void GJK::solve3(Simplex& simplex) {
+    auto cross = [](const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; };
+
+    glm::vec2 w1 = simplex.v[0].w;
+    glm::vec2 w2 = simplex.v[1].w;
+    glm::vec2 w3 = simplex.v[2].w;
+
+    // Edge regions
+    glm::vec2 e12 = w2 - w1;
+    float d12_1 = glm::dot(w2, e12);
+    float d12_2 = -glm::dot(w1, e12);
+
+    glm::vec2 e13 = w3 - w1;
+    float d13_1 = glm::dot(w3, e13);
+    float d13_2 = -glm::dot(w1, e13);
+
+    glm::vec2 e23 = w3 - w2;
+    float d23_1 = glm::dot(w3, e23);
+    float d23_2 = -glm::dot(w2, e23);
+
+    // Triangle regions
+    float n123 = cross(e12, e13);
+    float d123_1 = n123 * cross(w2, w3);
+    float d123_2 = n123 * cross(w3, w1);
+    float d123_3 = n123 * cross(w1, w2);
+
+    // w1 region
+    if (d12_2 <= 0.0f && d13_2 <= 0.0f) {
+        simplex.v[0].u = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // e12 region
+    if (d12_1 > 0.0f && d12_2 > 0.0f && d123_3 <= 0.0f) {
+        float inv = 1.0f / (d12_1 + d12_2);
+        simplex.v[0].u = d12_1 * inv;
+        simplex.v[1].u = d12_2 * inv;
+        simplex.count = 2;
+        return;
+    }
+
+    // e13 region
+    if (d13_1 > 0.0f && d13_2 > 0.0f && d123_2 <= 0.0f) {
+        float inv = 1.0f / (d13_1 + d13_2);
+        simplex.v[0].u = d13_1 * inv;
+        simplex.v[2].u = d13_2 * inv;
+        simplex.v[1] = simplex.v[2];
+        simplex.count = 2;
+        return;
+    }
+
+    // w2 region
+    if (d12_1 <= 0.0f && d23_2 <= 0.0f) {
+        simplex.v[0] = simplex.v[1];
+        simplex.v[0].u = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // w3 region
+    if (d13_1 <= 0.0f && d23_1 <= 0.0f) {
+        simplex.v[0] = simplex.v[2];
+        simplex.v[0].u = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // e23 region
+    if (d23_1 > 0.0f && d23_2 > 0.0f && d123_1 <= 0.0f) {
+        float inv = 1.0f / (d23_1 + d23_2);
+        simplex.v[1].u = d23_1 * inv;
+        simplex.v[2].u = d23_2 * inv;
+        simplex.v[0] = simplex.v[2];
+        simplex.count = 2;
+        return;
+    }
+
+    // Origin is inside the triangle
+    float inv = 1.0f / (d123_1 + d123_2 + d123_3);
+    simplex.v[0].u = d123_1 * inv;
+    simplex.v[1].u = d123_2 * inv;
+    simplex.v[2].u = d123_3 * inv;
+    simplex.count = 3;
+}
+
+DistanceResult GJK::coreDistance(const SupportShape& a, const SupportShape& b, Simplex& simplex) {
+    const int MAX_ITERATIONS = 32;
+    const float EPSILON = 1e-6f;
+
+    // Start from the direction between the shape origins
+    glm::vec2 initial = b.getPosition() - a.getPosition();
+    if (glm::dot(initial, initial) < EPSILON * EPSILON) initial = glm::vec2(1.0f, 0.0f);
+    simplex.v[0] = makeVertex(a, b, -initial);
+    simplex.count = 1;
+
+    for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+        // Keep the vertices around to detect cycling
+        glm::vec2 previous[3];
+        int previousCount = simplex.count;
+        for (int i = 0; i < simplex.count; i++) previous[i] = simplex.v[i].w;
+
+        if (simplex.count == 2) solve2(simplex);
+        else if (simplex.count == 3) solve3(simplex);
+
+        // The origin is enclosed: cores overlap
+        if (simplex.count == 3) break;
+
+        // Search towards the origin from the closest simplex feature
+        glm::vec2 direction;
+        if (simplex.count == 1) {
+            direction = -simplex.v[0].w;
+        } else {
+            glm::vec2 e12 = simplex.v[1].w - simplex.v[0].w;
+            float sign = e12.x * -simplex.v[0].w.y - e12.y * -simplex.v[0].w.x;
+            direction = sign > 0.0f ? glm::vec2(-e12.y, e12.x) : glm::vec2(e12.y, -e12.x);
+        }
+
+        // The origin lies on the simplex: cores touch
+        if (glm::dot(direction, direction) < EPSILON * EPSILON) break;
+
+        SimplexVertex vertex = makeVertex(a, b, direction);
+
+        // No new support point means no further progress
+        bool duplicate = false;
+        for (int i = 0; i < previousCount; i++) {
+            if (vertex.w == previous[i]) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate) break;
+
+        simplex.v[simplex.count++] = vertex;
+    }
+
+    // Witness points from the barycentric weights
+    DistanceResult result;
+    if (simplex.count == 3) {
+        glm::vec2 point = simplex.v[0].a * simplex.v[0].u + simplex.v[1].a * simplex.v[1].u
+                        + simplex.v[2].a * simplex.v[2].u;
+        result.pointA = point;
+        result.pointB = point;
+        result.coresOverlap = true;
+        return result;
+    }
+
+    for (int i = 0; i < simplex.count; i++) {
+        result.pointA += simplex.v[i].a * simplex.v[i].u;
+        result.pointB += simplex.v[i].b * simplex.v[i].u;
+    }
+    result.distance = glm::length(result.pointB - result.pointA);
+    result.coresOverlap = result.distance < EPSILON;
+    return result;
+}
+
+bool GJK::penetration(const SupportShape& a, const SupportShape& b, const Simplex& simplex,
+                      glm::vec2& normal, float& depth, glm::vec2& point) {
+    const int MAX_VERTICES = 64;
+    const int MAX_ITERATIONS = 48;
+    const float TOLERANCE = 1e-5f;
+    auto cross = [](const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; };
+
+    SimplexVertex polytope[MAX_VERTICES];
+    int count = simplex.count;
+    for (int i = 0; i < count; i++) polytope[i] = simplex.v[i];
+
+    // Grow a touching simplex into a triangle around the origin
+    const glm::vec2 searchDirections[4] = {
+        glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec2(-1.0f, 0.0f), glm::vec2(0.0f, -1.0f)
+    };
+    if (count == 1) {
+        for (const auto& direction : searchDirections) {
+            SimplexVertex vertex = makeVertex(a, b, direction);
+            if (glm::length(vertex.w - polytope[0].w) > TOLERANCE) {
+                polytope[count++] = vertex;
+                break;
+            }
+        }
+    }
+    if (count == 2) {
+        glm::vec2 edge = polytope[1].w - polytope[0].w;
+        glm::vec2 perpendicular(-edge.y, edge.x);
+        const float sides[2] = {1.0f, -1.0f};
+        for (float side : sides) {
+            SimplexVertex vertex = makeVertex(a, b, perpendicular * side);
+            if (std::abs(cross(edge, vertex.w - polytope[0].w)) > TOLERANCE) {
+                polytope[count++] = vertex;
+                break;
+            }
+        }
+    }
+
+    // Degenerate Minkowski difference (e.g. two points): no usable normal
+    if (count < 3) return false;
+
+    // Keep the polytope counter-clockwise so edge normals face outward
+    if (cross(polytope[1].w - polytope[0].w, polytope[2].w - polytope[0].w) < 0.0f) {
+        std::swap(polytope[1], polytope[2]);
+    }
+
+    for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+        // Find the edge closest to the origin
+        int closest = 0;
+        float closestDistance = INFINITY;
+        glm::vec2 closestNormal(0.0f);
+        for (int i = 0; i < count; i++) {
+            glm::vec2 edge = polytope[(i + 1) % count].w - polytope[i].w;
+            float length = glm::length(edge);
+            if (length < TOLERANCE) continue;
+
+            glm::vec2 edgeNormal = glm::vec2(edge.y, -edge.x) / length;
+            float distance = glm::dot(edgeNormal, polytope[i].w);
+            if (distance < closestDistance) {
+                closestDistance = distance;
+                closestNormal = edgeNormal;
+                closest = i;
+            }
+        }
+
+        SimplexVertex vertex = makeVertex(a, b, closestNormal);
+        bool converged = glm::dot(vertex.w, closestNormal) - closestDistance < TOLERANCE;
+
+        if (converged || count == MAX_VERTICES || iteration == MAX_ITERATIONS - 1) {
+            // Project the origin onto the closest edge to find the contact on A
+            const SimplexVertex& v1 = polytope[closest];
+            const SimplexVertex& v2 = polytope[(closest + 1) % count];
+            glm::vec2 edge = v2.w - v1.w;
+            float t = glm::clamp(-glm::dot(v1.w, edge) / glm::dot(edge, edge), 0.0f, 1.0f);
+
+            // The Minkowski face normal points against the A-to-B direction
+            normal = -closestNormal;
+            depth = std::max(0.0f, closestDistance);
+            point = v1.a + (v2.a - v1.a) * t;
+            return true;
+        }
+
+        // Insert the new support point after the closest edge
+        for (int i = count; i > closest + 1; i--) polytope[i] = polytope[i - 1];
+        polytope[closest + 1] = vertex;
+        count++;
+    }
+
+    return false;
+}
+
+DistanceResult GJK::distance(const SupportShape& a, const SupportShape& b) {
+    Simplex simplex;
+    DistanceResult result = coreDistance(a, b, simplex);
+    result.distance = std::max(0.0f, result.distance - a.getRadius() - b.getRadius());
+    return result;
+}
+
+ContactManifold GJK::collide(const SupportShape& a, const SupportShape& b) {
+    ContactManifold manifold;
+    Simplex simplex;
+    DistanceResult result = coreDistance(a, b, simplex);
+    float radii = a.getRadius() + b.getRadius();
+
+    if (!result.coresOverlap) {
+        // Separated cores: only the rounding radii can overlap
+        if (result.distance >= radii) return manifold;
+
+        manifold.normal = (result.pointB - result.pointA) / result.distance;
+        manifold.depth = radii - result.distance;
+        manifold.points[0] = result.pointA + manifold.normal * (a.getRadius() - manifold.depth * 0.5f);
+    }
+    else {
+        glm::vec2 normal, point;
+        float depth;
+        if (penetration(a, b, simplex, normal, depth, point)) {
+            manifold.normal = normal;
+            manifold.depth = depth + radii;
+            manifold.points[0] = point;
+        } else {
+            // Coincident degenerate cores: fall back to the direction between origins
+            glm::vec2 between = b.getPosition() - a.getPosition();
+            float length = glm::length(between);
+            manifold.normal = length > 1e-6f ? between / length : glm::vec2(0.0f, 1.0f);
+            manifold.depth = radii;
+            manifold.points[0] = result.pointA;
+        }
+    }
+
+    manifold.hit = true;
+    manifold.pointCount = 1;
+    return manifold;
+}
@@ -0,0 +1,180 @@
+#include "../include/Hud.hpp"
+#include "../include/Renderer.hpp"
+#include "../include/RenderSnapshot.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+// 5x7 bitmap font; each row's low five bits are its pixels, leftmost first
+struct Glyph {
+    char character;
+    uint8_t rows[7];
+};
+
+static const Glyph FONT[] = {
+    {'0', {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}},
+    {'1', {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'2', {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}},
+    {'3', {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}},
+    {'4', {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}},
+    {'5', {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}},
+    {'6', {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}},
+    {'7', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}},
+    {'8', {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}},
+    {'9', {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}},
+    {'A', {0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11}},
+    {'B', {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}},
+    {'C', {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}},
+    {'D', {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}},
+    {'E', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}},
+    {'F', {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}},
+    {'G', {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}},
+    {'H', {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}},
+    {'I', {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}},
+    {'J', {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}},
+    {'K', {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}},
+    {'L', {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}},
+    {'M', {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}},
+    {'N', {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}},
+    {'O', {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'P', {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}},
+    {'Q', {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}},
+    {'R', {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}},
+    {'S', {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}},
+    {'T', {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}},
+    {'U', {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}},
+    {'V', {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}},
+    {'W', {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}},
+    {'X', {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}},
+    {'Y', {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}},
+    {'Z', {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}},
+    {'.', {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}},
+    {':', {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}},
+    {'/', {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}},
+    {'%', {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}},
+    {'-', {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}},
+    {'+', {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}},
+    {'(', {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}},
+    {')', {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}},
+};
+
+static const Glyph* findGlyph(char c) {
+    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+    for (const auto& glyph : FONT) {
+        if (glyph.character == c) return &glyph;
+    }
+    return nullptr; // Spaces and unknown characters leave a gap
+}
+
+void Hud::recordFrame(float frameMs, float drawMs) {
+    frameTimes[nextSample] = frameMs;
+    nextSample = (nextSample + 1) % GRAPH_SAMPLES;
+    lastDrawMs = drawMs;
+}
+
+void Hud::drawText(const glm::vec2& topLeft, const std::string& text, const glm::vec3& color) const {
+    const float PIXEL = static_cast<float>(PIXEL_SIZE);
+    glm::vec2 origin = topLeft;
+    for (char c : text) {
+        if (const Glyph* glyph = findGlyph(c)) {
+            for (int row = 0; row < 7; row++) {
+                // One box per horizontal run of lit pixels
+                float top = origin.y - row * PIXEL;
+                for (int column = 0; column < 5;) {
+                    if (!(glyph->rows[row] & (0x10 >> column))) {
+                        column++;
+                        continue;
+                    }
+                    int start = column;
+                    while (column < 5 && (glyph->rows[row] & (0x10 >> column))) column++;
+                    Renderer::drawBox(glm::vec2(origin.x + start * PIXEL, top - PIXEL),
+                                      glm::vec2(origin.x + column * PIXEL, top), color);
+                }
+            }
+        }
+        origin.x += 6 * PIXEL;
+    }
+}
+
+void Hud::drawGraph(const glm::vec2& bottomLeft, const glm::vec2& size) const {
+    // Scale to at least two 60 Hz frames so a steady frame rate sits mid-graph
+    const float TARGET_MS = 1000.0f / 60.0f;
+    float scaleMs = std::max(2.0f * TARGET_MS, *std::max_element(frameTimes.begin(), frameTimes.end()));
+
+    Renderer::drawBox(bottomLeft, bottomLeft + size, glm::vec3(0.1f));
+    float targetY = bottomLeft.y + size.y * TARGET_MS / scaleMs;
+    Renderer::drawLine(glm::vec2(bottomLeft.x, targetY), glm::vec2(bottomLeft.x + size.x, targetY),
+                       glm::vec3(0.3f, 0.3f, 0.6f));
+
+    // Oldest sample on the left
+    glm::vec2 previous(0.0f);
+    for (int i = 0; i < GRAPH_SAMPLES; i++) {
+        float ms = frameTimes[(nextSample + i) % GRAPH_SAMPLES];
+        glm::vec2 point(bottomLeft.x + size.x * i / (GRAPH_SAMPLES - 1),
+                        bottomLeft.y + size.y * ms / scaleMs);
+        if (i > 0) {
+            glm::vec3 color = ms > TARGET_MS ? glm::vec3(1.0f, 0.4f, 0.2f) : glm::vec3(0.3f, 1.0f, 0.3f);
+            Renderer::drawLine(previous, point, color);
+        }
+        previous = point;
+    }
+}
+
+void Hud::draw(const RenderSnapshot& snapshot, int framebufferWidth, int framebufferHeight) {
+    // Average the accumulated phase times over the steps since the last refresh
+    const PhaseTimings& timings = snapshot.timings;
+    if (timings.steps < lastTimings.steps) lastTimings = PhaseTimings(); // Timings were reset
+    size_t steps = timings.steps - lastTimings.steps;
+    if (steps >= STEPS_PER_REFRESH) {
+        double perStep = 1.0 / steps;
+        stepAverages.broadphase = (timings.broadphase - lastTimings.broadphase) * perStep;
+        stepAverages.narrowphase = (timings.narrowphase - lastTimings.narrowphase) * perStep;
+        stepAverages.solver = (timings.solver - lastTimings.solver) * perStep;
+        stepAverages.integration = (timings.integration - lastTimings.integration) * perStep;
+        lastTimings = timings;
+    }
+
+    // Forces share the integration timer and boundaries the solver timer
+    const int LINES = 11;
+    char text[LINES][48];
+    std::snprintf(text[0], sizeof(text[0]), "BODIES      %zu (%zu SHOWN)", snapshot.totalBodies, snapshot.bodies.size());
+    std::snprintf(text[1], sizeof(text[1]), "PAIRS       %zu", snapshot.candidatePairs);
+    std::snprintf(text[2], sizeof(text[2]), "CONTACTS    %zu", snapshot.contacts);
+    std::snprintf(text[3], sizeof(text[3]), "STEP MS");
+    std::snprintf(text[4], sizeof(text[4]), " BROADPHASE  %.3f", stepAverages.broadphase);
+    std::snprintf(text[5], sizeof(text[5]), " NARROWPHASE %.3f", stepAverages.narrowphase);
+    std::snprintf(text[6], sizeof(text[6]), " SOLVE+BOUND %.3f", stepAverages.solver);
+    std::snprintf(text[7], sizeof(text[7]), " FORCE+INTEG %.3f", stepAverages.integration);
+    std::snprintf(text[8], sizeof(text[8]), "FRAME MS");
+    std::snprintf(text[9], sizeof(text[9]), " DRAW        %.3f", lastDrawMs);
+    std::snprintf(text[10], sizeof(text[10]), " TOTAL       %.3f",
+                  frameTimes[(nextSample + GRAPH_SAMPLES - 1) % GRAPH_SAMPLES]);
+
+    const float MARGIN = 8.0f;
+    const float LINE_HEIGHT = 9.0f * PIXEL_SIZE;
+    const glm::vec2 GRAPH_SIZE(240.0f, 60.0f);
+    glm::vec2 panelMin(MARGIN, framebufferHeight - MARGIN * 3 - LINES * LINE_HEIGHT - GRAPH_SIZE.y);
+    glm::vec2 panelMax(MARGIN * 2 + 32 * 6 * PIXEL_SIZE, framebufferHeight - MARGIN);
+
+    // Pixel coordinates with the origin at the bottom left
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0, framebufferWidth, 0.0, framebufferHeight, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    Renderer::beginFrame();
+    Renderer::drawBox(panelMin, panelMax, glm::vec3(0.0f, 0.0f, 0.15f));
+    for (int i = 0; i < LINES; i++) {
+        drawText(glm::vec2(MARGIN * 2, panelMax.y - MARGIN - i * LINE_HEIGHT), text[i], glm::vec3(1.0f));
+    }
+    drawGraph(glm::vec2(MARGIN * 2, panelMin.y + MARGIN), GRAPH_SIZE);
+    Renderer::flush();
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+}
@@ -0,0 +1,80 @@
+#include "../include/OffscreenContext.hpp"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <cstring>
+#include <iostream>
+
+OffscreenContext::~OffscreenContext() {
+    if (!display) return;
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context) eglDestroyContext(display, context);
+    if (surface) eglDestroySurface(display, surface);
+    eglTerminate(display);
+}
+
+// Prefer Mesa's surfaceless platform, which needs neither X11 nor a GPU
+static EGLDisplay openDisplay() {
+    EGLDisplay display = EGL_NO_DISPLAY;
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless") && getPlatformDisplay) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+#endif
+    if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    return display;
+}
+
+bool OffscreenContext::initialize(int frameWidth, int frameHeight) {
+    display = openDisplay();
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        std::cerr << "Failed to initialize EGL\n";
+        display = nullptr;
+        return false;
+    }
+
+    // Desktop OpenGL, since the renderer uses client vertex arrays
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL has no desktop OpenGL support\n";
+        return false;
+    }
+
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        std::cerr << "No EGL config with an OpenGL pbuffer\n";
+        return false;
+    }
+
+    const EGLint surfaceAttributes[] = {EGL_WIDTH, frameWidth, EGL_HEIGHT, frameHeight, EGL_NONE};
+    surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+    if (surface == EGL_NO_SURFACE || context == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(display, surface, surface, context)) {
+        std::cerr << "Failed to create an offscreen OpenGL context (EGL error 0x"
+                  << std::hex << eglGetError() << std::dec << ")\n";
+        return false;
+    }
+
+    width = frameWidth;
+    height = frameHeight;
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+void OffscreenContext::readPixels(std::vector<uint8_t>& pixels) const {
+    pixels.resize(static_cast<size_t>(width) * height * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+}
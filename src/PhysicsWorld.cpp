@@ -2,21 +2,112 @@
 #include "../include/Circle.hpp"
 #include "../include/Rectangle.hpp"
 #include "../include/Polygon.hpp"
-#include <GLFW/glfw3.h>
+#include "../include/ContinuousCollision.hpp"
+#include "../include/GJK.hpp"
+#include "../include/Profiler.hpp"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+
+// Milliseconds since a steady_clock time point
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
 
 void PhysicsWorld::update(float deltaTime) {
-    applyForces(deltaTime);
-    checkCollisions();
-    checkBoundaries();
-    
-    // Update positions
-    for (auto& obj : objects) {
-        obj->update(deltaTime);
+    PROFILE_FRAME();
+    PROFILE_ZONE("update");
+    substepTime = deltaTime / substeps;
+    debugDraw.clear();
+    stats = PipelineStats();
+    scratchCapacities(capacitiesBefore);
+
+    // Broadphase once per step, with bounds swept over the whole step. The
+    // sweep also serves as the velocity-scaled margin for speculative contacts.
+    auto phaseStart = std::chrono::steady_clock::now();
+    findCandidatePairs(deltaTime);
+    timings.broadphase += elapsedMs(phaseStart);
+
+    for (int step = 0; step < substeps; step++) {
+        phaseStart = std::chrono::steady_clock::now();
+        applyForces(substepTime);
+        timings.integration += elapsedMs(phaseStart);
+
+        phaseStart = std::chrono::steady_clock::now();
+        checkCollisions();
+        timings.narrowphase += elapsedMs(phaseStart);
+
+        phaseStart = std::chrono::steady_clock::now();
+        resolveCollisions();
+        checkBoundaries();
+        timings.solver += elapsedMs(phaseStart);
+
+        phaseStart = std::chrono::steady_clock::now();
+        integrate(substepTime);
+        timings.integration += elapsedMs(phaseStart);
     }
+    timings.steps++;
+    settleBounds();
+
+    for (const auto& obj : objects) {
+        if (obj->getIsStatic()) stats.staticBodies++;
+        else stats.dynamicBodies++;
+    }
+    stats.candidatePairs = candidatePairs.size();
+    ScratchCapacities capacitiesAfter;
+    scratchCapacities(capacitiesAfter);
+    for (size_t i = 0; i < SCRATCH_BUFFERS; i++) {
+        if (capacitiesAfter[i] > capacitiesBefore[i]) stats.allocations++;
+    }
+}
+
+void PhysicsWorld::scratchCapacities(ScratchCapacities& capacities) const {
+    // Swapped pairs of buffers are counted together so a swap is not a growth,
+    // and the per-thread buffers are summed so adding threads keeps the length
+    size_t slotContacts = 0;
+    size_t slotSpeculativeContacts = 0;
+    for (const auto& slot : narrowphaseSlots) {
+        slotContacts += slot.contacts.capacity();
+        slotSpeculativeContacts += slot.speculativeContacts.capacity();
+    }
+
+    capacities = {
+        candidatePairs.capacity() + previousPairs.capacity(),
+        candidateAxes.capacity() + previousAxes.capacity(),
+        contacts.capacity(),
+        speculativeContacts.capacity(),
+        sweptBounds.capacity(),
+        boundsOrder.capacity(),
+        oversizedBounds.capacity(),
+        settledBounds.capacity(),
+        gridEntries.capacity(),
+        bodyShapes.capacity(),
+        startPositions.capacity(),
+        startRotations.capacity(),
+        impactTimes.capacity(),
+        impactTargets.capacity(),
+        impactNormals.capacity(),
+        sweepVertices.capacity(),
+        narrowphaseSlots.capacity(),
+        slotContacts,
+        slotSpeculativeContacts
+    };
+}
+
+// Index into PipelineStats::SHAPE_NAMES
+static uint8_t shapeKind(const PhysicsObject& obj) {
+    if (dynamic_cast<const Circle*>(&obj)) return 0;
+    if (dynamic_cast<const Rectangle*>(&obj)) return 1;
+    return 2;
+}
+
+void PhysicsWorld::setThreadCount(int n) {
+    threadCount = n > 0 ? n : 1;
+    workerPool.resize(threadCount - 1);
 }
 
 void PhysicsWorld::applyForces(float deltaTime) {
+    PROFILE_ZONE("applyForces");
     for (auto& obj : objects) {
         if (!obj->getIsStatic()) {
             // Apply gravity
@@ -29,65 +120,429 @@ void PhysicsWorld::applyForces(float deltaTime) {
     }
 }
 
+void PhysicsWorld::findCandidatePairs(float deltaTime) {
+    PROFILE_ZONE("broadphase");
+    // Last step's pairs, to carry their cached separating axes over
+    previousPairs.swap(candidatePairs);
+    previousAxes.swap(candidateAxes);
+    candidatePairs.clear();
+
+    // Sweep each object's bounds over the step so pairs that only meet
+    // in a later substep are still reported
+    const float BOUNDS_MARGIN = 0.01f;
+    sweptBounds.resize(objects.size());
+    bodyShapes.resize(objects.size());
+    for (size_t i = 0; i < objects.size(); i++) {
+        bodyShapes[i] = shapeKind(*objects[i]);
+        AABB box = objects[i]->getBounds();
+        glm::vec2 motion = objects[i]->getVelocity() * deltaTime;
+        box.min += glm::min(motion, glm::vec2(0.0f)) - BOUNDS_MARGIN;
+        box.max += glm::max(motion, glm::vec2(0.0f)) + BOUNDS_MARGIN;
+        sweptBounds[i] = box;
+    }
+    boundsOrder.clear();
+    settledBounds.clear();
+    boundsDrift = 0.0f;
+
+#ifdef COLLISION_DEBUG_DRAW
+    for (const auto& box : sweptBounds) {
+        debugDraw.box(box, glm::vec3(0.4f, 0.4f, 0.4f));
+    }
+#endif
+
+    switch (broadphaseMode) {
+        case BroadphaseMode::BruteForce:
+            findPairsBruteForce();
+            break;
+        case BroadphaseMode::SweepAndPrune:
+            findPairsSweepAndPrune();
+            break;
+        case BroadphaseMode::UniformGrid:
+            findPairsUniformGrid();
+            break;
+    }
+
+    // Sort by body indices and drop duplicates, so resolution order does not
+    // depend on the broadphase mode and stays deterministic
+    std::sort(candidatePairs.begin(), candidatePairs.end());
+    candidatePairs.erase(std::unique(candidatePairs.begin(), candidatePairs.end()), candidatePairs.end());
+
+    // Carry cached separating axes over for pairs that are still candidates.
+    // Both lists are sorted, so one merge pass lines them up.
+    candidateAxes.assign(candidatePairs.size(), SeparatingAxisCache());
+    size_t previous = 0;
+    for (size_t i = 0; i < candidatePairs.size(); i++) {
+        while (previous < previousPairs.size() && previousPairs[previous] < candidatePairs[i]) previous++;
+        if (previous < previousPairs.size() && previousPairs[previous] == candidatePairs[i]) {
+            candidateAxes[i] = previousAxes[previous];
+        }
+    }
+}
+
+void PhysicsWorld::addCandidatePair(size_t a, size_t b) {
+    // Skip if both objects are static
+    if (objects[a]->getIsStatic() && objects[b]->getIsStatic()) return;
+
+    if (sweptBounds[a].overlaps(sweptBounds[b])) {
+        candidatePairs.emplace_back(std::min(a, b), std::max(a, b));
+    }
+}
+
+void PhysicsWorld::findPairsBruteForce() {
+    for (size_t a = 0; a < objects.size(); a++) {
+        for (size_t b = a + 1; b < objects.size(); b++) {
+            addCandidatePair(a, b);
+        }
+    }
+}
+
+void PhysicsWorld::sortBoundsOrder() const {
+    // A body much wider than the average, such as a floor, would push every
+    // query's search start back to the left edge of the world. Those are kept
+    // aside so widestBounds follows the ordinary bodies only.
+    const float OVERSIZED_FACTOR = 8.0f;
+    float totalWidth = 0.0f;
+    for (const auto& box : sweptBounds) totalWidth += box.max.x - box.min.x;
+    oversizedWidth = sweptBounds.empty() ? 0.0f : OVERSIZED_FACTOR * totalWidth / sweptBounds.size();
+
+    boundsOrder.resize(sweptBounds.size());
+    oversizedBounds.clear();
+    widestBounds = 0.0f;
+    for (size_t i = 0; i < boundsOrder.size(); i++) {
+        boundsOrder[i] = i;
+        float width = sweptBounds[i].max.x - sweptBounds[i].min.x;
+        if (width > oversizedWidth) oversizedBounds.push_back(i);
+        else widestBounds = std::max(widestBounds, width);
+    }
+    std::sort(boundsOrder.begin(), boundsOrder.end(), [this](size_t a, size_t b) {
+        return sweptBounds[a].min.x < sweptBounds[b].min.x;
+    });
+}
+
+void PhysicsWorld::findPairsSweepAndPrune() {
+    // Sort and sweep along the x axis; the order is kept for region queries
+    sortBoundsOrder();
+    const auto& order = boundsOrder;
+
+    for (size_t i = 0; i < order.size(); i++) {
+        size_t a = order[i];
+        for (size_t j = i + 1; j < order.size(); j++) {
+            size_t b = order[j];
+            if (sweptBounds[b].min.x > sweptBounds[a].max.x) break;
+            addCandidatePair(a, b);
+        }
+    }
+}
+
+void PhysicsWorld::findPairsUniformGrid() {
+    if (objects.empty()) return;
+
+    // Cells twice the average bounds size keep most bodies in one to four cells
+    glm::vec2 totalSize(0.0f);
+    for (const auto& box : sweptBounds) totalSize += box.max - box.min;
+    float cellSize = std::max(2.0f * std::max(totalSize.x, totalSize.y) / sweptBounds.size(), 1e-3f);
+
+    // One (cell, body) entry per covered cell, sorted so each cell's bodies are contiguous
+    auto& entries = gridEntries;
+    entries.clear();
+    entries.reserve(objects.size() * 2);
+    for (size_t i = 0; i < sweptBounds.size(); i++) {
+        int minX = static_cast<int>(std::floor(sweptBounds[i].min.x / cellSize));
+        int minY = static_cast<int>(std::floor(sweptBounds[i].min.y / cellSize));
+        int maxX = static_cast<int>(std::floor(sweptBounds[i].max.x / cellSize));
+        int maxY = static_cast<int>(std::floor(sweptBounds[i].max.y / cellSize));
+        for (int x = minX; x <= maxX; x++) {
+            for (int y = minY; y <= maxY; y++) {
+                uint64_t cell = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+                entries.emplace_back(cell, i);
+            }
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+
+#ifdef COLLISION_DEBUG_DRAW
+    // Outline each occupied cell once
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (i > 0 && entries[i].first == entries[i - 1].first) continue;
+        glm::vec2 corner(static_cast<int32_t>(entries[i].first >> 32),
+                         static_cast<int32_t>(entries[i].first & 0xffffffffu));
+        debugDraw.box(AABB{corner * cellSize, (corner + 1.0f) * cellSize}, glm::vec3(0.2f, 0.2f, 0.6f));
+    }
+#endif
+
+    // Pairs sharing several cells are reported once per cell and removed afterwards
+    for (size_t start = 0; start < entries.size();) {
+        size_t end = start;
+        while (end < entries.size() && entries[end].first == entries[start].first) end++;
+        for (size_t i = start; i < end; i++) {
+            for (size_t j = i + 1; j < end; j++) {
+                addCandidatePair(entries[i].second, entries[j].second);
+            }
+        }
+        start = end;
+    }
+}
+
 void PhysicsWorld::checkCollisions() {
+    PROFILE_ZONE("narrowphase");
+    contacts.clear();
+    speculativeContacts.clear();
+
+    // Each thread takes a contiguous slice of the candidate pairs and
+    // collects into its own slot, merged in slice order afterwards so the
+    // result does not depend on the thread count
+    size_t slices = std::min(static_cast<size_t>(threadCount), std::max<size_t>(candidatePairs.size(), 1));
+    if (narrowphaseSlots.size() < slices) narrowphaseSlots.resize(slices);
+
+    auto detectSlice = [this, slices](size_t slice) {
+        PROFILE_ZONE("narrowphase slice");
+        NarrowphaseSlot& out = narrowphaseSlots[slice];
+        out.contacts.clear();
+        out.speculativeContacts.clear();
+        std::fill(&out.tests[0][0], &out.tests[0][0] + sizeof(out.tests) / sizeof(size_t), 0);
+        out.hits = 0;
+        out.contactPoints = 0;
+        out.axisCacheQueries = 0;
+        out.axisCacheHits = 0;
+
+        size_t begin = candidatePairs.size() * slice / slices;
+        size_t end = candidatePairs.size() * (slice + 1) / slices;
+
+        for (size_t i = begin; i < end; i++) {
+            const auto& pair = candidatePairs[i];
+            auto& obj1 = objects[pair.first];
+            auto& obj2 = objects[pair.second];
+
+            // One query detects the overlap and returns everything resolution needs,
+            // trying the face that separated the pair last time first
+            SeparatingAxisCache& cache = candidateAxes[i];
+            if (cache.owner >= 0) out.axisCacheQueries++;
+            cache.cachedReject = false;
+
+            ContactManifold manifold;
+            bool hit = obj1->collide(*obj2, manifold, &cache);
+            if (cache.cachedReject) out.axisCacheHits++;
+
+            uint8_t kind1 = bodyShapes[pair.first];
+            uint8_t kind2 = bodyShapes[pair.second];
+            out.tests[std::min(kind1, kind2)][std::max(kind1, kind2)]++;
+            if (hit) {
+                out.hits++;
+                out.contactPoints += manifold.pointCount;
+                out.contacts.push_back({pair.first, pair.second, manifold});
+                continue;
+            }
+
+            if (!speculativeContactsEnabled) continue;
+
+            // Closing speed along the line between the closest points, at the
+            // current pose so the cached rotors are used rather than trig
+            DistanceResult separation = GJK::distance(*obj1, *obj2);
+            glm::vec2 between = separation.pointA - separation.pointB;
+            float length = glm::length(between);
+            float gap = separation.distance;
+            if (gap <= 0.0f || length < 1e-6f) continue;
+
+            glm::vec2 normal = between / length;
+            float closingSpeed = -glm::dot(obj1->getVelocity() - obj2->getVelocity(), normal);
+            if (closingSpeed * substepTime > gap) {
+                out.speculativeContacts.push_back({pair.first, pair.second, normal, gap});
+            }
+        }
+    };
+
+    // The calling thread handles the first slice, the pool's workers the rest
+    workerPool.run(slices, detectSlice);
+
+    for (size_t slice = 0; slice < slices; slice++) {
+        const NarrowphaseSlot& out = narrowphaseSlots[slice];
+        contacts.insert(contacts.end(), out.contacts.begin(), out.contacts.end());
+        speculativeContacts.insert(speculativeContacts.end(),
+                                   out.speculativeContacts.begin(), out.speculativeContacts.end());
+        axisCacheQueries += out.axisCacheQueries;
+        axisCacheHits += out.axisCacheHits;
+
+        for (int a = 0; a < PipelineStats::SHAPE_KINDS; a++) {
+            for (int b = 0; b < PipelineStats::SHAPE_KINDS; b++) {
+                stats.narrowphaseTests[a][b] += out.tests[a][b];
+            }
+        }
+        stats.hits += out.hits;
+        stats.contactPoints += out.contactPoints;
+        stats.speculativeContacts += out.speculativeContacts.size();
+    }
+
+#ifdef COLLISION_DEBUG_DRAW
+    // Contact points with their normals, after the merge so threads never share the list
+    const float NORMAL_LENGTH = 0.05f;
+    for (const auto& contact : contacts) {
+        for (int i = 0; i < contact.manifold.pointCount; i++) {
+            glm::vec2 point = contact.manifold.points[i];
+            debugDraw.point(point, glm::vec3(1.0f, 0.0f, 0.0f));
+            debugDraw.line(point, point + contact.manifold.normal * NORMAL_LENGTH, glm::vec3(1.0f, 1.0f, 0.0f));
+        }
+    }
+#endif
+}
+
+void PhysicsWorld::resolveCollisions() {
+    PROFILE_ZONE("solve");
+    stats.solverIterations += solverIterations;
+    // Velocity passes reuse the manifolds from the narrowphase
+    for (int iteration = 0; iteration < solverIterations; iteration++) {
+        for (const auto& contact : contacts) {
+            applyImpactImpulse(*objects[contact.first], *objects[contact.second], -contact.manifold.normal);
+        }
+        for (const auto& contact : speculativeContacts) {
+            applySpeculativeImpulse(*objects[contact.first], *objects[contact.second], contact);
+        }
+    }
+
+    // Then remove the overlap once per substep
+    for (const auto& contact : contacts) {
+        correctPositions(*objects[contact.first], *objects[contact.second], contact.manifold);
+    }
+}
+
+void PhysicsWorld::correctPositions(PhysicsObject& obj1, PhysicsObject& obj2, const ContactManifold& manifold) {
+    // Add a small extra separation to prevent sticking
+    const float SEPARATION_SLOP = 0.001f;
+
+    float invMass1 = obj1.getIsStatic() ? 0.0f : 1.0f / obj1.getMass();
+    float invMass2 = obj2.getIsStatic() ? 0.0f : 1.0f / obj2.getMass();
+    if (invMass1 + invMass2 <= 0.0f) return;
+
+    glm::vec2 correction = manifold.normal * (manifold.depth + SEPARATION_SLOP) / (invMass1 + invMass2);
+    obj1.setPosition(obj1.getPosition() - correction * invMass1);
+    obj2.setPosition(obj2.getPosition() + correction * invMass2);
+}
+
+void PhysicsWorld::applySpeculativeImpulse(PhysicsObject& obj1, PhysicsObject& obj2,
+                                           const SpeculativeContact& contact) {
+    // Approach speed that closes the gap exactly by the end of the substep
+    float allowedApproach = substepTime > 0.0f ? contact.gap / substepTime : INFINITY;
+    float velAlongNormal = glm::dot(obj1.getVelocity() - obj2.getVelocity(), contact.normal);
+    if (velAlongNormal >= -allowedApproach) return;
+
+    float invMass1 = obj1.getIsStatic() ? 0.0f : 1.0f / obj1.getMass();
+    float invMass2 = obj2.getIsStatic() ? 0.0f : 1.0f / obj2.getMass();
+    if (invMass1 + invMass2 <= 0.0f) return;
+
+    // Inelastic: the bodies have not touched yet, so there is nothing to bounce off
+    float j = -(velAlongNormal + allowedApproach) / (invMass1 + invMass2);
+    glm::vec2 impulse = j * contact.normal;
+    obj1.setVelocity(obj1.getVelocity() + impulse * invMass1);
+    obj2.setVelocity(obj2.getVelocity() - impulse * invMass2);
+}
+
+void PhysicsWorld::integrate(float deltaTime) {
+    PROFILE_ZONE("integrate");
+    // Remember where everything starts so bullets can be swept afterwards
+    startPositions.resize(objects.size());
+    startRotations.resize(objects.size());
     for (size_t i = 0; i < objects.size(); i++) {
-        for (size_t j = i + 1; j < objects.size(); j++) {
-            auto& obj1 = objects[i];
-            auto& obj2 = objects[j];
-            
-            // Skip if both objects are static
-            if (obj1->getIsStatic() && obj2->getIsStatic()) continue;
-            
-            bool collision = obj1->checkCollision(*obj2) || obj2->checkCollision(*obj1);
-            if (collision) {
-                // Handle Circle-Circle collision
-                if (auto circle1 = std::dynamic_pointer_cast<Circle>(obj1)) {
-                    if (auto circle2 = std::dynamic_pointer_cast<Circle>(obj2)) {
-                        circle1->resolveCollision(*circle2);
-                    }
-                    else if (auto rect2 = std::dynamic_pointer_cast<Rectangle>(obj2)) {
-                        // Only let circle handle circle-rectangle collision
-                        circle1->resolveCollision(*rect2);
-                    }
-                    else if (auto poly2 = std::dynamic_pointer_cast<Polygon>(obj2)) {
-                        // Let polygon handle circle-polygon collision
-                        poly2->resolveCollision(*circle1);
-                    }
-                }
-                // Handle Rectangle-Rectangle collision
-                else if (auto rect1 = std::dynamic_pointer_cast<Rectangle>(obj1)) {
-                    if (auto rect2 = std::dynamic_pointer_cast<Rectangle>(obj2)) {
-                        rect1->resolveCollision(*rect2);
-                    }
-                    else if (auto circle2 = std::dynamic_pointer_cast<Circle>(obj2)) {
-                        // Let circle handle circle-rectangle collision
-                        circle2->resolveCollision(*rect1);
-                    }
-                    else if (auto poly2 = std::dynamic_pointer_cast<Polygon>(obj2)) {
-                        // Let polygon handle polygon-rectangle collision
-                        poly2->resolveCollision(*rect1);
-                    }
-                }
-                // Handle Polygon collisions
-                else if (auto poly1 = std::dynamic_pointer_cast<Polygon>(obj1)) {
-                    if (auto poly2 = std::dynamic_pointer_cast<Polygon>(obj2)) {
-                        poly1->resolveCollision(*poly2);
-                    }
-                    else if (auto circle2 = std::dynamic_pointer_cast<Circle>(obj2)) {
-                        // Handle polygon-circle collision
-                        poly1->resolveCollision(*circle2);
-                    }
-                    else if (auto rect2 = std::dynamic_pointer_cast<Rectangle>(obj2)) {
-                        // Handle polygon-rectangle collision
-                        poly1->resolveCollision(*rect2);
-                    }
-                }
+        startPositions[i] = objects[i]->getPosition();
+        startRotations[i] = objects[i]->getRotation();
+    }
+
+    for (auto& obj : objects) {
+        obj->update(deltaTime);
+    }
+
+    sweepBullets();
+}
+
+void PhysicsWorld::sweepBullets() {
+    // Sweep a slightly smaller circle so a bullet stopped at its time of
+    // impact overlaps the target and the next narrowphase picks it up
+    const float BULLET_SKIN = 0.05f;
+
+    impactTimes.assign(objects.size(), 1.0f);
+    impactTargets.resize(objects.size());
+    impactNormals.resize(objects.size());
+    bool anyImpact = false;
+
+    for (const auto& pair : candidatePairs) {
+        for (int side = 0; side < 2; side++) {
+            size_t bulletIndex = side == 0 ? pair.first : pair.second;
+            size_t targetIndex = side == 0 ? pair.second : pair.first;
+
+            const PhysicsObject& bullet = *objects[bulletIndex];
+            const PhysicsObject& target = *objects[targetIndex];
+            if (!bullet.getIsBullet() || bullet.getIsStatic()) continue;
+
+            TimeOfImpact toi;
+            if (auto circle = dynamic_cast<const Circle*>(&bullet)) {
+                // Sweep in the target's frame: relative motion against its end pose
+                glm::vec2 bulletMotion = circle->getPosition() - startPositions[bulletIndex];
+                glm::vec2 targetMotion = target.getPosition() - startPositions[targetIndex];
+                glm::vec2 sweepStart = target.getPosition() + startPositions[bulletIndex] - startPositions[targetIndex];
+
+                toi = ContinuousCollision::sweepCircle(
+                    sweepStart, bulletMotion - targetMotion,
+                    circle->getRadius() * (1.0f - BULLET_SKIN), target, sweepVertices);
+            }
+            else {
+                // Rotating convex shapes advance conservatively over both motions
+                Pose bulletStart{startPositions[bulletIndex], startRotations[bulletIndex]};
+                Pose bulletEnd{bullet.getPosition(), bullet.getRotation()};
+                Pose targetStart{startPositions[targetIndex], startRotations[targetIndex]};
+                Pose targetEnd{target.getPosition(), target.getRotation()};
+
+                toi = ContinuousCollision::conservativeAdvancement(
+                    bullet, bulletStart, bulletEnd, target, targetStart, targetEnd);
+            }
+
+            if (toi.hit && toi.time < impactTimes[bulletIndex]) {
+                impactTimes[bulletIndex] = toi.time;
+                impactTargets[bulletIndex] = targetIndex;
+                impactNormals[bulletIndex] = toi.normal;
+                anyImpact = true;
             }
         }
     }
+
+    if (!anyImpact) return;
+
+    // Advance bullets only as far as their first time of impact
+    for (size_t i = 0; i < objects.size(); i++) {
+        if (impactTimes[i] >= 1.0f) continue;
+
+        PhysicsObject& bullet = *objects[i];
+        float t = impactTimes[i];
+        bullet.setPosition(startPositions[i] + (bullet.getPosition() - startPositions[i]) * t);
+        if (dynamic_cast<Circle*>(&bullet)) continue;
+
+        bullet.setRotation(startRotations[i] + (bullet.getRotation() - startRotations[i]) * t);
+
+        // Conservative advancement stops just short of contact, so respond now
+        applyImpactImpulse(bullet, *objects[impactTargets[i]], impactNormals[i]);
+    }
+}
+
+void PhysicsWorld::applyImpactImpulse(PhysicsObject& obj1, PhysicsObject& obj2, const glm::vec2& normal) {
+    // Relative velocity along the normal
+    float velAlongNormal = glm::dot(obj1.getVelocity() - obj2.getVelocity(), normal);
+
+    // Don't resolve if objects are moving apart
+    if (velAlongNormal > 0) return;
+
+    float invMass1 = obj1.getIsStatic() ? 0.0f : 1.0f / obj1.getMass();
+    float invMass2 = obj2.getIsStatic() ? 0.0f : 1.0f / obj2.getMass();
+    if (invMass1 + invMass2 <= 0.0f) return;
+
+    // Calculate impulse scalar
+    float e = std::min(obj1.getRestitution(), obj2.getRestitution());
+    float j = -(1 + e) * velAlongNormal / (invMass1 + invMass2);
+
+    // Apply impulse
+    glm::vec2 impulse = j * normal;
+    obj1.setVelocity(obj1.getVelocity() + impulse * invMass1);
+    obj2.setVelocity(obj2.getVelocity() - impulse * invMass2);
 }
 
 void PhysicsWorld::checkBoundaries() {
+    PROFILE_ZONE("checkBoundaries");
     const float BOUNCE_FACTOR = 0.8f;
     
     for (auto& obj : objects) {
@@ -143,45 +598,29 @@ void PhysicsWorld::checkBoundaries() {
         }
         // Handle polygon boundaries
         else if (auto poly = std::dynamic_pointer_cast<Polygon>(obj)) {
-            auto vertices = poly->getWorldVertices();
-            bool needsAdjustment = false;
+            // The bounds are the extreme hull vertices, found from support
+            // points without building the world space vertex list
+            AABB bounds = poly->getBounds();
             glm::vec2 adjustment(0.0f);
             
-            // Check all vertices against boundaries
-            for (const auto& vertex : vertices) {
-                // Left boundary
-                if (vertex.x < -windowWidth/2) {
-                    float dx = -windowWidth/2 - vertex.x;
-                    adjustment.x = std::max(adjustment.x, dx);
-                    needsAdjustment = true;
-                }
-                // Right boundary
-                else if (vertex.x > windowWidth/2) {
-                    float dx = windowWidth/2 - vertex.x;
-                    adjustment.x = std::min(adjustment.x, dx);
-                    needsAdjustment = true;
-                }
-                
-                // Bottom boundary
-                if (vertex.y < -windowHeight/2) {
-                    float dy = -windowHeight/2 - vertex.y;
-                    adjustment.y = std::max(adjustment.y, dy);
-                    needsAdjustment = true;
-                }
-                // Top boundary
-                else if (vertex.y > windowHeight/2) {
-                    float dy = windowHeight/2 - vertex.y;
-                    adjustment.y = std::min(adjustment.y, dy);
-                    needsAdjustment = true;
-                }
+            // Left and right boundaries
+            if (bounds.min.x < -windowWidth/2) {
+                adjustment.x = -windowWidth/2 - bounds.min.x;
+            } else if (bounds.max.x > windowWidth/2) {
+                adjustment.x = windowWidth/2 - bounds.max.x;
             }
             
-            // Apply adjustment and bounce if needed
-            if (needsAdjustment) {
-                pos += adjustment;
-                if (adjustment.x != 0.0f) vel.x = -vel.x * BOUNCE_FACTOR;
-                if (adjustment.y != 0.0f) vel.y = -vel.y * BOUNCE_FACTOR;
+            // Top and bottom boundaries
+            if (bounds.min.y < -windowHeight/2) {
+                adjustment.y = -windowHeight/2 - bounds.min.y;
+            } else if (bounds.max.y > windowHeight/2) {
+                adjustment.y = windowHeight/2 - bounds.max.y;
             }
+            
+            // Apply adjustment and bounce if needed
+            pos += adjustment;
+            if (adjustment.x != 0.0f) vel.x = -vel.x * BOUNCE_FACTOR;
+            if (adjustment.y != 0.0f) vel.y = -vel.y * BOUNCE_FACTOR;
         }
         
         obj->setPosition(pos);
@@ -189,12 +628,51 @@ void PhysicsWorld::checkBoundaries() {
     }
 }
 
-void PhysicsWorld::draw() const {
-    for (const auto& obj : objects) {
-        obj->draw();
+void PhysicsWorld::settleBounds() {
+    settledBounds.resize(sweptBounds.size());
+    boundsDrift = 0.0f;
+    for (size_t i = 0; i < settledBounds.size(); i++) {
+        AABB box = objects[i]->getBounds();
+        glm::vec2 below = sweptBounds[i].min - box.min;
+        glm::vec2 above = box.max - sweptBounds[i].max;
+        boundsDrift = std::max({boundsDrift, below.x, below.y, above.x, above.y});
+        settledBounds[i] = box;
     }
 }
 
+void PhysicsWorld::queryRegion(const AABB& region, std::vector<size_t>& result) const {
+    size_t first = result.size();
+
+    // The sweep-and-prune order is reused when it is current
+    if (boundsOrder.size() != sweptBounds.size()) sortBoundsOrder();
+
+    // Search the swept order grown by the drift, then test where bodies ended.
+    // Without a settled pass since the broadphase, the swept bounds are tested.
+    bool settled = settledBounds.size() == sweptBounds.size();
+    const std::vector<AABB>& bounds = settled ? settledBounds : sweptBounds;
+    float drift = settled ? boundsDrift : 0.0f;
+
+    // Only ordinary bounds starting within one widest width left of the region can reach it
+    auto begin = std::lower_bound(boundsOrder.begin(), boundsOrder.end(), region.min.x - widestBounds - drift,
+        [this](size_t i, float x) { return sweptBounds[i].min.x < x; });
+    for (auto it = begin; it != boundsOrder.end(); ++it) {
+        const AABB& swept = sweptBounds[*it];
+        if (swept.min.x > region.max.x + drift) break;
+        if (swept.max.x - swept.min.x > oversizedWidth) continue;
+        if (bounds[*it].overlaps(region)) result.push_back(*it);
+    }
+    for (size_t i : oversizedBounds) {
+        if (bounds[i].overlaps(region)) result.push_back(i);
+    }
+
+    // Objects added since the last broadphase have no bounds yet
+    for (size_t i = sweptBounds.size(); i < objects.size(); i++) {
+        if (objects[i]->getBounds().overlaps(region)) result.push_back(i);
+    }
+
+    std::sort(result.begin() + first, result.end());
+}
+
 std::shared_ptr<PhysicsObject> PhysicsWorld::findObjectAtPosition(const glm::vec2& pos) {
     // Check circles first (more precise for clicking)
     for (auto it = objects.rbegin(); it != objects.rend(); ++it) {
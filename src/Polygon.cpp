@@ -2,179 +2,281 @@
 #include "Polygon.hpp"
 #include "Circle.hpp"
 #include "Rectangle.hpp"
-#include <glm/gtx/rotate_vector.hpp>
 #include <glm/gtx/norm.hpp>
+#include <limits>
+#include <algorithm>
+#include <cmath>
 
 std::vector<glm::vec2> Polygon::getWorldVertices() const {
     std::vector<glm::vec2> worldVertices;
-    worldVertices.reserve(vertices.size());
+    getWorldVertices(worldVertices);
+    return worldVertices;
+}
+
+void Polygon::getWorldVertices(std::vector<glm::vec2>& out) const {
+    out.clear();
+    out.reserve(vertices.size());
     
     for (const auto& vertex : vertices) {
-        // Rotate the vertex
-        glm::vec2 rotatedVertex = glm::rotate(vertex, rotation);
-        // Translate to world position
-        worldVertices.push_back(position + rotatedVertex);
+        // Rotate the vertex and translate to world position
+        out.push_back(position + rotateToWorld(vertex));
     }
-    
-    return worldVertices;
 }
 
-bool Polygon::checkCollision(const PhysicsObject& other) const {
-    // Get this polygon's vertices in world space
-    const auto& worldVerts = getWorldVertices();
-    
+AABB Polygon::getBounds() const {
+    // Extreme hull vertices along the world axes, found in local space
+    glm::vec2 right = rotateToLocal(glm::vec2(1.0f, 0.0f));
+    glm::vec2 up = rotateToLocal(glm::vec2(0.0f, 1.0f));
+
+    AABB bounds;
+    bounds.min = position + glm::vec2(glm::dot(getSupportPoint(-right), right),
+                                      glm::dot(getSupportPoint(-up), up));
+    bounds.max = position + glm::vec2(glm::dot(getSupportPoint(right), right),
+                                      glm::dot(getSupportPoint(up), up));
+    return bounds;
+}
+
+glm::vec2 Polygon::getSupportPoint(const glm::vec2& localDirection) const {
+    if (hull.empty()) return glm::vec2(0.0f);
+
+    // Start from the last support vertex: with coherent directions the
+    // answer is at most a few edges away around the hull
+    size_t count = hull.size();
+    size_t best = supportHint.load(std::memory_order_relaxed);
+    if (best >= count) best = 0;
+    float bestProjection = glm::dot(hull[best], localDirection);
+
+    // Dot products along a convex hull rise to one peak, so climb
+    // forward if the next vertex is better, otherwise backward
+    size_t next = (best + 1) % count;
+    float projection = glm::dot(hull[next], localDirection);
+    if (projection > bestProjection) {
+        while (projection > bestProjection) {
+            best = next;
+            bestProjection = projection;
+            next = (best + 1) % count;
+            projection = glm::dot(hull[next], localDirection);
+        }
+    } else {
+        size_t prev = (best + count - 1) % count;
+        projection = glm::dot(hull[prev], localDirection);
+        while (projection > bestProjection) {
+            best = prev;
+            bestProjection = projection;
+            prev = (best + count - 1) % count;
+            projection = glm::dot(hull[prev], localDirection);
+        }
+    }
+
+    supportHint.store(best, std::memory_order_relaxed);
+    return hull[best];
+}
+
+void Polygon::computeShapeData() {
+    // Counter-clockwise convex hull (monotone chain), so neighbouring
+    // entries are neighbouring vertices and collinear points are dropped
+    std::vector<glm::vec2> points = vertices;
+    std::sort(points.begin(), points.end(), [](const glm::vec2& a, const glm::vec2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+    auto cross = [](const glm::vec2& o, const glm::vec2& a, const glm::vec2& b) {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    };
+
+    hull.clear();
+    if (points.size() < 3) {
+        hull = points;
+    } else {
+        hull.resize(2 * points.size());
+        size_t k = 0;
+        // Lower chain, then upper chain
+        for (size_t i = 0; i < points.size(); i++) {
+            while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0f) k--;
+            hull[k++] = points[i];
+        }
+        for (size_t i = points.size() - 1, lower = k + 1; i > 0; i--) {
+            while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0f) k--;
+            hull[k++] = points[i - 1];
+        }
+        hull.resize(k - 1);
+    }
+    supportHint.store(0, std::memory_order_relaxed);
+
+    // Outward edge normals of the counter-clockwise hull
+    normals.clear();
+    normals.reserve(hull.size());
+    boundingRadius = 0.0f;
+    for (size_t i = 0; i < hull.size(); i++) {
+        glm::vec2 edge = hull[(i + 1) % hull.size()] - hull[i];
+        normals.push_back(glm::normalize(glm::vec2(edge.y, -edge.x)));
+        boundingRadius = std::max(boundingRadius, glm::length(hull[i]));
+    }
+}
+
+bool Polygon::collideCircle(const Circle& circle, ContactManifold& manifold) const {
+    manifold.hit = false;
+    if (hull.size() < 3) return false;
+
+    float radius = circle.getRadius();
+
+    // Circle center in the polygon's local space
+    glm::vec2 center = rotateToLocal(circle.getPosition() - position);
+
+    // Face of maximum separation
+    size_t face = 0;
+    float separation = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < hull.size(); i++) {
+        float s = glm::dot(normals[i], center - hull[i]);
+        if (s > radius) return false;
+        if (s > separation) {
+            separation = s;
+            face = i;
+        }
+    }
+
+    const glm::vec2& v1 = hull[face];
+    const glm::vec2& v2 = hull[(face + 1) % hull.size()];
+    glm::vec2 localNormal;
+    glm::vec2 localPoint;
+
+    if (separation <= 0.0f) {
+        // Center is inside the polygon: push out through the nearest face
+        localNormal = normals[face];
+        manifold.depth = radius - separation;
+        localPoint = center - localNormal * separation;
+    }
+    else if (glm::dot(center - v1, v2 - v1) <= 0.0f) {
+        // Vertex region of v1
+        glm::vec2 diff = center - v1;
+        float distanceSquared = glm::dot(diff, diff);
+        if (distanceSquared > radius * radius) return false;
+        float distance = std::sqrt(distanceSquared);
+        localNormal = distance > 0.0001f ? diff / distance : normals[face];
+        manifold.depth = radius - distance;
+        localPoint = v1;
+    }
+    else if (glm::dot(center - v2, v1 - v2) <= 0.0f) {
+        // Vertex region of v2
+        glm::vec2 diff = center - v2;
+        float distanceSquared = glm::dot(diff, diff);
+        if (distanceSquared > radius * radius) return false;
+        float distance = std::sqrt(distanceSquared);
+        localNormal = distance > 0.0001f ? diff / distance : normals[face];
+        manifold.depth = radius - distance;
+        localPoint = v2;
+    }
+    else {
+        // Face region
+        localNormal = normals[face];
+        manifold.depth = radius - separation;
+        localPoint = center - localNormal * separation;
+    }
+
+    // Back to world space
+    manifold.normal = rotateToWorld(localNormal);
+    manifold.points[0] = position + rotateToWorld(localPoint);
+    manifold.pointCount = 1;
+    manifold.hit = true;
+    return true;
+}
+
+bool Polygon::collide(const PhysicsObject& other, ContactManifold& manifold,
+                      SeparatingAxisCache* cache) const {
+    manifold.hit = false;
+
+    // Bounding circles must overlap before any exact test
+    if (!boundingCirclesOverlap(other)) return false;
+
     // Handle Circle collision
     if (auto circle = dynamic_cast<const Circle*>(&other)) {
-        glm::vec2 circleCenter = circle->getPosition();
-        float circleRadius = circle->getRadius();
-        
-        // For each edge of the polygon
-        for (size_t i = 0; i < worldVerts.size(); i++) {
-            const glm::vec2& v1 = worldVerts[i];
-            const glm::vec2& v2 = worldVerts[(i + 1) % worldVerts.size()];
-            
-            // Get vector from v1 to v2
-            glm::vec2 edge = v2 - v1;
-            // Get vector from v1 to circle center
-            glm::vec2 v1ToCircle = circleCenter - v1;
-            
-            // Project v1ToCircle onto edge
-            float edgeLength = glm::length(edge);
-            glm::vec2 edgeNorm = edge / edgeLength;
-            float projection = glm::dot(v1ToCircle, edgeNorm);
-            
-            glm::vec2 closestPoint;
-            if (projection <= 0) {
-                closestPoint = v1;
-            } else if (projection >= edgeLength) {
-                closestPoint = v2;
-            } else {
-                closestPoint = v1 + edgeNorm * projection;
-            }
-            
-            // Check if circle intersects with closest point
-            float distanceSquared = glm::length2(circleCenter - closestPoint);
-            if (distanceSquared <= circleRadius * circleRadius) {
-                return true;
-            }
-        }
-        return false;
+        return collideCircle(*circle, manifold);
     }
+
     // Handle Rectangle collision
-    else if (auto rect = dynamic_cast<const Rectangle*>(&other)) {
-        // Get rectangle vertices
-        std::vector<glm::vec2> rectVerts;
-        glm::vec2 rectPos = rect->getPosition();
-        float rectWidth = rect->getWidth();
-        float rectHeight = rect->getHeight();
-        float rectRot = rect->getRotation();
-        
-        // Calculate rectangle vertices
-        glm::vec2 halfSize(rectWidth/2, rectHeight/2);
-        glm::vec2 v1 = glm::rotate(glm::vec2(-halfSize.x, -halfSize.y), rectRot);
-        glm::vec2 v2 = glm::rotate(glm::vec2(halfSize.x, -halfSize.y), rectRot);
-        glm::vec2 v3 = glm::rotate(glm::vec2(halfSize.x, halfSize.y), rectRot);
-        glm::vec2 v4 = glm::rotate(glm::vec2(-halfSize.x, halfSize.y), rectRot);
-        
-        rectVerts.push_back(rectPos + v1);
-        rectVerts.push_back(rectPos + v2);
-        rectVerts.push_back(rectPos + v3);
-        rectVerts.push_back(rectPos + v4);
-        
+    if (auto rect = dynamic_cast<const Rectangle*>(&other)) {
         // Use SAT for polygon-polygon collision
-        return checkPolygonPolygonCollision(worldVerts, rectVerts);
+        return collideConvex(*rect, manifold, cache);
     }
     // Handle Polygon collision
     else if (auto poly = dynamic_cast<const Polygon*>(&other)) {
-        return checkPolygonPolygonCollision(worldVerts, poly->getWorldVertices());
+        return collideConvex(*poly, manifold, cache);
     }
     
     return false;
 }
 
-bool Polygon::checkPolygonPolygonCollision(const std::vector<glm::vec2>& vertsA, 
-                                         const std::vector<glm::vec2>& vertsB) const {
-    // Get edges for both polygons
-    auto getEdges = [](const std::vector<glm::vec2>& verts) {
-        std::vector<glm::vec2> edges;
-        for (size_t i = 0; i < verts.size(); i++) {
-            glm::vec2 edge = verts[(i + 1) % verts.size()] - verts[i];
-            edges.push_back(glm::normalize(edge));
-        }
-        return edges;
+bool Polygon::collideConvex(const PhysicsObject& other, ContactManifold& manifold,
+                            SeparatingAxisCache* cache) const {
+    manifold.hit = false;
+    const Polygon* otherPoly = dynamic_cast<const Polygon*>(&other);
+    if (hull.size() < 3 || (otherPoly && otherPoly->hull.size() < 3)) return false;
+
+    // A rectangle's faces in its local space
+    static const glm::vec2 BOX_NORMALS[4] = {
+        glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec2(-1.0f, 0.0f), glm::vec2(0.0f, -1.0f)
     };
-    
-    auto edgesA = getEdges(vertsA);
-    auto edgesB = getEdges(vertsB);
-    
-    // Combine all edges to test
-    std::vector<glm::vec2> axes;
-    for (const auto& edge : edgesA) axes.push_back(glm::vec2(-edge.y, edge.x));
-    for (const auto& edge : edgesB) axes.push_back(glm::vec2(-edge.y, edge.x));
-    
-    // Test projection onto each axis
-    for (const auto& axis : axes) {
-        float minA = std::numeric_limits<float>::max();
-        float maxA = std::numeric_limits<float>::lowest();
-        float minB = std::numeric_limits<float>::max();
-        float maxB = std::numeric_limits<float>::lowest();
-        
-        // Project vertices of polygon A
-        for (const auto& v : vertsA) {
-            float proj = glm::dot(v, axis);
-            minA = std::min(minA, proj);
-            maxA = std::max(maxA, proj);
-        }
-        
-        // Project vertices of polygon B
-        for (const auto& v : vertsB) {
-            float proj = glm::dot(v, axis);
-            minB = std::min(minB, proj);
-            maxB = std::max(maxB, proj);
-        }
-        
-        // Check for separation
-        if (maxA < minB || maxB < minA) {
-            return false;
+    size_t faceCounts[2] = {normals.size(), otherPoly ? otherPoly->normals.size() : 4};
+
+    // Signed distance of the deepest point of one shape past face i of the
+    // other. Only support points are needed, and sweeping the faces in
+    // order turns the query direction monotonically, so each hill climb
+    // resumes next to where the previous one stopped. The axis comes back
+    // pointing from this polygon to the other.
+    auto separationOn = [&](int owner, size_t i, glm::vec2& axis, glm::vec2& deepest) {
+        if (owner == 0) {
+            axis = rotateToWorld(normals[i]);
+            deepest = other.getPosition() + other.rotateToWorld(other.getSupportPoint(other.rotateToLocal(-axis)));
+            return glm::dot(deepest - position - rotateToWorld(hull[i]), axis);
         }
-    }
-    
-    return true;
-}
+        glm::vec2 localNormal = otherPoly ? otherPoly->normals[i] : BOX_NORMALS[i];
+        glm::vec2 facePoint = otherPoly ? otherPoly->hull[i] : other.getSupportPoint(localNormal);
+        glm::vec2 faceNormal = other.rotateToWorld(localNormal);
+        axis = -faceNormal;
+        deepest = position + rotateToWorld(getSupportPoint(rotateToLocal(axis)));
+        return glm::dot(deepest - other.getPosition() - other.rotateToWorld(facePoint), faceNormal);
+    };
 
-void Polygon::resolveCollision(PhysicsObject& other) {
-    if (getIsStatic() && other.getIsStatic()) return;
+    glm::vec2 axis;
+    glm::vec2 deepest;
 
-    // Calculate collision normal
-    glm::vec2 normal;
-    
-    if (auto circle = dynamic_cast<Circle*>(&other)) {
-        // For circle collision, use direction from polygon center to circle center
-        normal = glm::normalize(circle->getPosition() - position);
+    // The face that separated the pair last time usually still does
+    if (cache && cache->owner >= 0 && static_cast<size_t>(cache->face) < faceCounts[cache->owner] &&
+        separationOn(cache->owner, cache->face, axis, deepest) > 0.0f) {
+        cache->cachedReject = true;
+        return false;
     }
-    else {
-        // For polygon collision, use direction between centers
-        normal = glm::normalize(other.getPosition() - position);
+
+    // The face with the largest separation is the minimum penetration axis
+    float maxSeparation = std::numeric_limits<float>::lowest();
+    glm::vec2 normal(0.0f);
+    glm::vec2 point(0.0f);
+
+    for (int owner = 0; owner < 2; owner++) {
+        for (size_t i = 0; i < faceCounts[owner]; i++) {
+            float separation = separationOn(owner, i, axis, deepest);
+
+            // Check for separation
+            if (separation > 0.0f) {
+                if (cache) {
+                    cache->owner = owner;
+                    cache->face = static_cast<int>(i);
+                }
+                return false;
+            }
+            if (separation > maxSeparation) {
+                maxSeparation = separation;
+                normal = axis;
+                point = deepest;
+            }
+        }
     }
-    
-    glm::vec2 relativeVelocity = other.getVelocity() - getVelocity();
-    float velocityAlongNormal = glm::dot(relativeVelocity, normal);
-    
-    // Only resolve if objects are moving toward each other
-    if (velocityAlongNormal > 0) return;
-    
-    float restitutionCombined = std::min(getRestitution(), other.getRestitution());
-    float j = -(1.0f + restitutionCombined) * velocityAlongNormal;
-    j /= (1.0f / getMass()) + (1.0f / other.getMass());
-    
-    glm::vec2 impulse = j * normal;
-    
-    // Apply impulse
-    if (!getIsStatic()) setVelocity(getVelocity() - impulse / getMass());
-    if (!other.getIsStatic()) other.setVelocity(other.getVelocity() + impulse / other.getMass());
-    
-    // Prevent overlap by moving objects apart slightly
-    const float separationFactor = 0.01f; // Small separation to prevent sticking
-    if (!getIsStatic()) setPosition(getPosition() - normal * separationFactor);
-    if (!other.getIsStatic()) other.setPosition(other.getPosition() + normal * separationFactor);
+
+    manifold.normal = normal;
+    manifold.depth = -maxSeparation;
+    manifold.points[0] = point;
+    manifold.pointCount = 1;
+    manifold.hit = true;
+    return true;
 }
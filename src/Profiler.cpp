@@ -0,0 +1,112 @@
+#include "../include/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+// Fixed ring of the newest zones finished by one thread
+struct ProfileRing {
+    uint32_t track{0};  // Track of the thread currently owning the ring
+    uint32_t depth{0};
+    std::vector<ProfileZone> zones = std::vector<ProfileZone>(Profiler::RING_CAPACITY);
+    std::atomic<uint64_t> written{0}; // Zones ever written; the newest is at (written - 1) % capacity
+};
+
+static std::mutex registryMutex;
+static std::vector<std::unique_ptr<ProfileRing>> rings; // Every ring ever created
+static std::vector<ProfileRing*> freeRings;             // Rings whose thread has exited
+static std::vector<std::string> trackNames;             // Indexed by track, empty when unnamed
+static uint32_t nextTrack{0};
+static std::atomic<uint64_t> currentFrame{0};
+
+// Hands the thread's ring back when the thread exits
+struct RingHandle {
+    ProfileRing* ring{nullptr};
+
+    ~RingHandle() {
+        if (!ring) return;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        freeRings.push_back(ring);
+    }
+};
+
+static thread_local RingHandle threadHandle;
+
+// The registry lock is only taken the first time a thread records
+static ProfileRing& threadRing() {
+    if (!threadHandle.ring) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        if (!freeRings.empty()) {
+            threadHandle.ring = freeRings.back();
+            freeRings.pop_back();
+        } else {
+            rings.push_back(std::make_unique<ProfileRing>());
+            threadHandle.ring = rings.back().get();
+        }
+        threadHandle.ring->track = nextTrack++;
+    }
+    return *threadHandle.ring;
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::beginFrame() {
+    currentFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t Profiler::getFrame() {
+    return currentFrame.load(std::memory_order_relaxed);
+}
+
+uint32_t Profiler::getThreadIndex() {
+    return threadRing().track;
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    uint32_t track = threadRing().track;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (track >= trackNames.size()) trackNames.resize(track + 1);
+    trackNames[track] = name;
+}
+
+std::string Profiler::getThreadName(uint32_t thread) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return thread < trackNames.size() ? trackNames[thread] : std::string();
+}
+
+uint32_t Profiler::enterZone(uint32_t& depth) {
+    ProfileRing& ring = threadRing();
+    depth = ring.depth++;
+    return ring.track;
+}
+
+void Profiler::leaveZone(const ProfileZone& zone) {
+    ProfileRing& ring = threadRing();
+    ring.depth--;
+    uint64_t slot = ring.written.load(std::memory_order_relaxed);
+    ring.zones[slot % RING_CAPACITY] = zone;
+    ring.written.store(slot + 1, std::memory_order_release);
+}
+
+void Profiler::collectFrame(uint64_t frame, std::vector<ProfileZone>& zones) {
+    size_t first = zones.size();
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& ring : rings) {
+            uint64_t written = ring->written.load(std::memory_order_acquire);
+            uint64_t oldest = written > RING_CAPACITY ? written - RING_CAPACITY : 0;
+            for (uint64_t i = oldest; i < written; i++) {
+                const ProfileZone& zone = ring->zones[i % RING_CAPACITY];
+                if (zone.frame == frame) zones.push_back(zone);
+            }
+        }
+    }
+
+    std::sort(zones.begin() + first, zones.end(), [](const ProfileZone& a, const ProfileZone& b) {
+        return a.thread != b.thread ? a.thread < b.thread : a.startNs < b.startNs;
+    });
+}
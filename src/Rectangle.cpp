@@ -1,14 +1,21 @@
 #include "../include/Rectangle.hpp"
 #include "../include/Circle.hpp"
-#include <GLFW/glfw3.h>
+#include "../include/Polygon.hpp"
+#include "../include/GJK.hpp"
 #include <cmath>
 
 std::vector<glm::vec2> Rectangle::getVertices() const {
     std::vector<glm::vec2> vertices;
+    getVertices(vertices);
+    return vertices;
+}
+
+void Rectangle::getVertices(std::vector<glm::vec2>& vertices) const {
+    vertices.clear();
     vertices.reserve(4);
     
-    float cosA = cos(rotation);
-    float sinA = sin(rotation);
+    float cosA = rotor.x;
+    float sinA = rotor.y;
     
     // Calculate half dimensions
     float hw = width / 2.0f;
@@ -19,265 +26,145 @@ std::vector<glm::vec2> Rectangle::getVertices() const {
     vertices.push_back(position + glm::vec2(-hw * cosA - hh * sinA, -hw * sinA + hh * cosA));
     vertices.push_back(position + glm::vec2(-hw * cosA + hh * sinA, -hw * sinA - hh * cosA));
     vertices.push_back(position + glm::vec2(hw * cosA + hh * sinA, hw * sinA - hh * cosA));
-    
-    return vertices;
 }
 
-bool Rectangle::checkCollision(const PhysicsObject& other) const {
-    // Check if other object is a circle
-    const Circle* circle = dynamic_cast<const Circle*>(&other);
-    if (circle) {
-        // Handle circle-rectangle collision
-        float circleRadius = circle->getRadius();
-        glm::vec2 circleCenter = circle->getPosition();
-        
-        // Transform circle center to rectangle's local space
-        glm::vec2 localCircleCenter = circleCenter - position;
-        float cosA = cos(-rotation);
-        float sinA = sin(-rotation);
-        localCircleCenter = glm::vec2(
-            localCircleCenter.x * cosA - localCircleCenter.y * sinA,
-            localCircleCenter.x * sinA + localCircleCenter.y * cosA
-        );
-        
-        // Find closest point on rectangle to circle center
-        float closestX = std::max(-width/2.0f, std::min(width/2.0f, localCircleCenter.x));
-        float closestY = std::max(-height/2.0f, std::min(height/2.0f, localCircleCenter.y));
-        
-        // Calculate distance between closest point and circle center
-        glm::vec2 closest(closestX, closestY);
-        glm::vec2 difference = localCircleCenter - closest;
-        float distanceSquared = glm::dot(difference, difference);
-        
-        return distanceSquared <= (circleRadius * circleRadius);
-    }
-    
-    // Check if other object is a rectangle
-    const Rectangle* rect = dynamic_cast<const Rectangle*>(&other);
-    if (rect) {
-        // Get vertices of both rectangles
-        auto vertices1 = getVertices();
-        auto vertices2 = rect->getVertices();
-        
-        // Separating Axis Theorem (SAT)
-        std::vector<glm::vec2> axes;
-        
-        // Get axes from this rectangle
-        for (int i = 0; i < 4; i++) {
-            glm::vec2 edge = vertices1[(i + 1) % 4] - vertices1[i];
-            axes.push_back(glm::normalize(glm::vec2(-edge.y, edge.x)));
-        }
-        
-        // Get axes from other rectangle
-        for (int i = 0; i < 4; i++) {
-            glm::vec2 edge = vertices2[(i + 1) % 4] - vertices2[i];
-            axes.push_back(glm::normalize(glm::vec2(-edge.y, edge.x)));
-        }
-        
-        // Project vertices onto each axis
-        for (const auto& axis : axes) {
-            float min1 = INFINITY, max1 = -INFINITY;
-            float min2 = INFINITY, max2 = -INFINITY;
-            
-            // Project first rectangle
-            for (const auto& v : vertices1) {
-                float proj = glm::dot(v, axis);
-                min1 = std::min(min1, proj);
-                max1 = std::max(max1, proj);
-            }
-            
-            // Project second rectangle
-            for (const auto& v : vertices2) {
-                float proj = glm::dot(v, axis);
-                min2 = std::min(min2, proj);
-                max2 = std::max(max2, proj);
-            }
-            
-            // Check for separation
-            if (min1 > max2 || min2 > max1) {
-                return false;
-            }
+AABB Rectangle::getBounds() const {
+    // Extent of the rotated box along the world axes
+    float cosA = std::abs(rotor.x);
+    float sinA = std::abs(rotor.y);
+    glm::vec2 extent(
+        width / 2.0f * cosA + height / 2.0f * sinA,
+        width / 2.0f * sinA + height / 2.0f * cosA
+    );
+    return AABB{position - extent, position + extent};
+}
+
+bool Rectangle::collideRectangle(const Rectangle& other, ContactManifold& manifold,
+                                 SeparatingAxisCache* cache) const {
+    manifold.hit = false;
+
+    glm::vec2 halfA(width / 2.0f, height / 2.0f);
+    glm::vec2 halfB(other.width / 2.0f, other.height / 2.0f);
+    glm::vec2 d = other.position - position;
+
+    // Axis-aligned fast path (a half turn is still axis-aligned)
+    if (rotor.y == 0.0f && other.rotor.y == 0.0f) {
+        float overlapX = halfA.x + halfB.x - std::abs(d.x);
+        float overlapY = halfA.y + halfB.y - std::abs(d.y);
+        if (overlapX < 0.0f || overlapY < 0.0f) return false;
+
+        if (overlapX < overlapY) {
+            manifold.normal = glm::vec2(d.x < 0.0f ? -1.0f : 1.0f, 0.0f);
+            manifold.depth = overlapX;
+        } else {
+            manifold.normal = glm::vec2(0.0f, d.y < 0.0f ? -1.0f : 1.0f);
+            manifold.depth = overlapY;
         }
-        
+        manifold.points[0] = other.position + glm::vec2(
+            manifold.normal.x != 0.0f ? -manifold.normal.x * halfB.x : glm::clamp(-d.x, -halfB.x, halfB.x),
+            manifold.normal.y != 0.0f ? -manifold.normal.y * halfB.y : glm::clamp(-d.y, -halfB.y, halfB.y));
+        manifold.pointCount = 1;
+        manifold.hit = true;
         return true;
     }
-    
-    return false;
-}
 
-void Rectangle::resolveCollision(PhysicsObject& other) {
-    // Handle collision with circle
-    Circle* circle = dynamic_cast<Circle*>(&other);
-    if (circle) {
-        // Transform circle center to rectangle's local space
-        glm::vec2 localCircleCenter = circle->getPosition() - position;
-        float cosA = cos(-rotation);
-        float sinA = sin(-rotation);
-        localCircleCenter = glm::vec2(
-            localCircleCenter.x * cosA - localCircleCenter.y * sinA,
-            localCircleCenter.x * sinA + localCircleCenter.y * cosA
-        );
-        
-        // Find closest point on rectangle to circle center
-        float closestX = std::max(-width/2.0f, std::min(width/2.0f, localCircleCenter.x));
-        float closestY = std::max(-height/2.0f, std::min(height/2.0f, localCircleCenter.y));
-        glm::vec2 closestPoint(closestX, closestY);
-        
-        // Transform closest point back to world space
-        glm::vec2 worldClosestPoint = position + glm::vec2(
-            closestPoint.x * cosA - closestPoint.y * sinA,
-            closestPoint.x * sinA + closestPoint.y * cosA
-        );
-        
-        // Calculate collision normal
-        glm::vec2 normal = glm::normalize(circle->getPosition() - worldClosestPoint);
-        
-        // Calculate relative velocity
-        glm::vec2 relativeVel = velocity - circle->getVelocity();
-        
-        // Calculate relative velocity along the normal
-        float velAlongNormal = glm::dot(relativeVel, normal);
-        
-        // Don't resolve if objects are moving apart
-        if (velAlongNormal > 0) return;
-        
-        // Calculate restitution
-        float e = std::min(restitution, circle->getRestitution());
-        
-        // Calculate impulse scalar
-        float j = -(1 + e) * velAlongNormal;
-        j /= 1/mass + 1/circle->getMass();
-        
-        // Apply impulse
-        glm::vec2 impulse = j * normal;
-        if (!isStatic) {
-            velocity -= impulse / mass;
-        }
-        if (!circle->getIsStatic()) {
-            circle->setVelocity(circle->getVelocity() + impulse / circle->getMass());
-        }
-        
-        // Prevent objects from sticking together by adding a small separation
-        float penetrationDepth = circle->getRadius() - glm::length(circle->getPosition() - worldClosestPoint);
-        if (penetrationDepth > 0) {
-            glm::vec2 separation = normal * (penetrationDepth + 0.001f);
-            if (!isStatic) {
-                position -= separation * 0.5f;
-            }
-            if (!circle->getIsStatic()) {
-                circle->setPosition(circle->getPosition() + separation * 0.5f);
-            }
+    // Unit face axes come straight from the rotors, no normalization needed
+    glm::vec2 axesA[2] = {rotor, glm::vec2(-rotor.y, rotor.x)};
+    glm::vec2 axesB[2] = {other.rotor, glm::vec2(-other.rotor.y, other.rotor.x)};
+
+    // |axesA[i] . axesB[j]| is shared by every projection radius
+    float absDot[2][2];
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            absDot[i][j] = std::abs(glm::dot(axesA[i], axesB[j]));
         }
     }
-    
-    // Handle collision with rectangle
-    Rectangle* rect = dynamic_cast<Rectangle*>(&other);
-    if (rect) {
-        // Get vertices of both rectangles
-        auto vertices1 = getVertices();
-        auto vertices2 = rect->getVertices();
-        
-        // Find the collision normal and minimum overlap using SAT
-        glm::vec2 normal(0.0f);
-        float minOverlap = INFINITY;
-        
-        // Check all axes
-        std::vector<glm::vec2> axes;
-        
-        // Get axes from this rectangle
-        for (int i = 0; i < 4; i++) {
-            glm::vec2 edge = vertices1[(i + 1) % 4] - vertices1[i];
-            axes.push_back(glm::normalize(glm::vec2(-edge.y, edge.x)));
-        }
-        
-        // Get axes from other rectangle
-        for (int i = 0; i < 4; i++) {
-            glm::vec2 edge = vertices2[(i + 1) % 4] - vertices2[i];
-            axes.push_back(glm::normalize(glm::vec2(-edge.y, edge.x)));
+
+    // Signed overlap on face axis i of the given box, with the axis oriented toward the other box
+    auto overlapOn = [&](int owner, int i, glm::vec2& axis) {
+        float distance;
+        float overlap;
+        if (owner == 0) {
+            // Axes of this box: its own radius is just the half extent
+            float radiusB = halfB.x * absDot[i][0] + halfB.y * absDot[i][1];
+            distance = glm::dot(d, axesA[i]);
+            overlap = halfA[i] + radiusB - std::abs(distance);
+            axis = axesA[i];
+        } else {
+            // Axes of the other box
+            float radiusA = halfA.x * absDot[0][i] + halfA.y * absDot[1][i];
+            distance = glm::dot(d, axesB[i]);
+            overlap = radiusA + halfB[i] - std::abs(distance);
+            axis = axesB[i];
         }
-        
-        // Find axis with minimum overlap
-        for (const auto& axis : axes) {
-            float min1 = INFINITY, max1 = -INFINITY;
-            float min2 = INFINITY, max2 = -INFINITY;
-            
-            // Project first rectangle
-            for (const auto& v : vertices1) {
-                float proj = glm::dot(v, axis);
-                min1 = std::min(min1, proj);
-                max1 = std::max(max1, proj);
-            }
-            
-            // Project second rectangle
-            for (const auto& v : vertices2) {
-                float proj = glm::dot(v, axis);
-                min2 = std::min(min2, proj);
-                max2 = std::max(max2, proj);
+        if (distance < 0.0f) axis = -axis;
+        return overlap;
+    };
+
+    glm::vec2 axis;
+
+    // The face that separated the pair last time usually still does
+    if (cache && cache->owner >= 0 && overlapOn(cache->owner, cache->face, axis) < 0.0f) {
+        cache->cachedReject = true;
+        return false;
+    }
+
+    float minOverlap = INFINITY;
+    glm::vec2 normal(0.0f);
+
+    for (int owner = 0; owner < 2; owner++) {
+        for (int i = 0; i < 2; i++) {
+            float overlap = overlapOn(owner, i, axis);
+            if (overlap < 0.0f) {
+                if (cache) {
+                    cache->owner = owner;
+                    cache->face = i;
+                }
+                return false;
             }
-            
-            // Calculate overlap
-            float overlap = std::min(max1 - min2, max2 - min1);
-            
-            // If this is the smallest overlap we've found, save it
             if (overlap < minOverlap) {
                 minOverlap = overlap;
                 normal = axis;
-                
-                // Make sure normal points from rect1 to rect2
-                glm::vec2 center1 = position;
-                glm::vec2 center2 = rect->getPosition();
-                if (glm::dot(center2 - center1, normal) < 0) {
-                    normal = -normal;
-                }
-            }
-        }
-        
-        // Calculate relative velocity
-        glm::vec2 relativeVel = velocity - rect->getVelocity();
-        
-        // Calculate relative velocity along the normal
-        float velAlongNormal = glm::dot(relativeVel, normal);
-        
-        // Don't resolve if objects are moving apart
-        if (velAlongNormal > 0) return;
-        
-        // Calculate restitution
-        float e = std::min(restitution, rect->getRestitution());
-        
-        // Calculate impulse scalar
-        float j = -(1 + e) * velAlongNormal;
-        j /= 1/mass + 1/rect->getMass();
-        
-        // Calculate final impulse with adjusted magnitude
-        float dotProduct = std::abs(glm::dot(normal, glm::vec2(1.0f, 0.0f))); // Check if collision is more horizontal
-        float impulseFactor = dotProduct > 0.8f ? 0.8f : 1.2f; // Reduce impulse for side collisions
-        
-        glm::vec2 impulse = j * normal * impulseFactor;
-        
-        // Apply impulse
-        if (!isStatic) {
-            velocity -= impulse / mass;
-        }
-        if (!rect->getIsStatic()) {
-            rect->setVelocity(rect->getVelocity() + impulse / rect->getMass());
-        }
-        
-        // Separate the rectangles
-        if (minOverlap > 0) {
-            float totalMass = mass + rect->getMass();
-            float ratio1 = !isStatic ? rect->getMass() / totalMass : 0.0f;
-            float ratio2 = !rect->getIsStatic() ? mass / totalMass : 0.0f;
-            
-            // Add a small extra separation to prevent sticking
-            float separationDistance = minOverlap + 0.001f;
-            
-            // Apply separation based on mass ratio
-            if (!isStatic) {
-                position -= normal * separationDistance * ratio1;
-            }
-            if (!rect->getIsStatic()) {
-                rect->setPosition(rect->getPosition() + normal * separationDistance * ratio2);
             }
         }
     }
+
+    // Deepest corner of the other box along the normal
+    float signX = glm::dot(axesB[0], normal) > 0.0f ? 1.0f : -1.0f;
+    float signY = glm::dot(axesB[1], normal) > 0.0f ? 1.0f : -1.0f;
+    manifold.points[0] = other.position - axesB[0] * (halfB.x * signX) - axesB[1] * (halfB.y * signY);
+    manifold.pointCount = 1;
+    manifold.normal = normal;
+    manifold.depth = minOverlap;
+    manifold.hit = true;
+    return true;
+}
+
+bool Rectangle::collide(const PhysicsObject& other, ContactManifold& manifold,
+                        SeparatingAxisCache* cache) const {
+    manifold.hit = false;
+
+    // Let the circle handle circle-rectangle collision, then flip the normal
+    if (dynamic_cast<const Circle*>(&other)) {
+        if (!other.collide(*this, manifold)) return false;
+        manifold.normal = -manifold.normal;
+        return true;
+    }
+    
+    // Bounding circles must overlap before running SAT
+    if (!boundingCirclesOverlap(other)) return false;
+
+    // Check if other object is a rectangle
+    const Rectangle* rect = dynamic_cast<const Rectangle*>(&other);
+    if (rect) {
+        return collideRectangle(*rect, manifold, cache);
+    }
+
+    // Any other convex shape goes through the generic GJK path
+    if (dynamic_cast<const Polygon*>(&other)) {
+        manifold = GJK::collide(*this, other);
+        return manifold.hit;
+    }
+    
+    return false;
 }
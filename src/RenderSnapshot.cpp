@@ -0,0 +1,54 @@
+#include "../include/RenderSnapshot.hpp"
+#include "../include/PhysicsWorld.hpp"
+#include "../include/Circle.hpp"
+#include "../include/Rectangle.hpp"
+#include "../include/Polygon.hpp"
+
+void RenderSnapshot::capture(const PhysicsWorld& world, uint64_t stepIndex, const AABB& view) {
+    bodies.clear();
+    polygonVertices.clear();
+    showVelocityVectors = PhysicsObject::getShowVelocityVectors();
+    step = stepIndex;
+    totalBodies = world.getObjects().size();
+    candidatePairs = world.getCandidatePairs().size();
+    contacts = world.getContacts().size();
+    timings = world.getTimings();
+    debugDraw = world.getDebugDraw();
+
+    // Only bodies the broadphase places in view are copied
+    visible.clear();
+    world.queryRegion(view, visible);
+
+    for (size_t index : visible) {
+        const auto& obj = world.getObjects()[index];
+        SnapshotBody body;
+        body.position = obj->getPosition();
+        body.rotor = obj->getRotor();
+        body.velocity = obj->getVelocity();
+
+        if (auto circle = dynamic_cast<const Circle*>(obj.get())) {
+            body.shape = SnapshotShape::Circle;
+            body.size = glm::vec2(circle->getRadius(), 0.0f);
+            body.color = circle->getColor();
+        }
+        else if (auto rect = dynamic_cast<const Rectangle*>(obj.get())) {
+            body.shape = SnapshotShape::Rectangle;
+            body.size = glm::vec2(rect->getWidth(), rect->getHeight());
+            body.color = rect->getColor();
+        }
+        else if (auto poly = dynamic_cast<const Polygon*>(obj.get())) {
+            const auto& vertices = poly->getLocalVertices();
+            body.shape = SnapshotShape::Polygon;
+            body.size = glm::vec2(poly->getBoundingRadius());
+            body.color = poly->getColor();
+            body.firstVertex = static_cast<uint32_t>(polygonVertices.size());
+            body.vertexCount = static_cast<uint32_t>(vertices.size());
+            polygonVertices.insert(polygonVertices.end(), vertices.begin(), vertices.end());
+        }
+        else {
+            continue;
+        }
+
+        bodies.push_back(body);
+    }
+}
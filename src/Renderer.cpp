@@ -0,0 +1,68 @@
+#include "../include/Renderer.hpp"
+#include "../include/PhysicsWorld.hpp"
+#include "../include/RenderSnapshot.hpp"
+#include "../include/DebugDraw.hpp"
+#include "../include/Circle.hpp"
+#include "../include/Rectangle.hpp"
+#include "../include/Polygon.hpp"
+
+void Renderer::drawObject(const PhysicsObject& object) {
+    if (auto circle = dynamic_cast<const Circle*>(&object)) {
+        drawCircle(circle->getPosition(), circle->getRadius(), circle->getColor());
+    }
+    else if (auto rect = dynamic_cast<const Rectangle*>(&object)) {
+        drawRectangle(rect->getPosition(), rect->getWidth(), rect->getHeight(),
+                      rect->getRotor(), rect->getColor());
+    }
+    else if (auto poly = dynamic_cast<const Polygon*>(&object)) {
+        const auto& vertices = poly->getLocalVertices();
+        drawPolygon(poly->getPosition(), vertices.data(), vertices.size(), poly->getBoundingRadius(),
+                    poly->getRotor(), poly->getColor());
+    }
+
+    if (PhysicsObject::getShowVelocityVectors()) {
+        drawVelocityVector(object.getPosition(), object.getVelocity() * 0.1f);
+    }
+}
+
+void Renderer::drawWorld(const PhysicsWorld& world, const AABB& view) {
+    // Collect the shapes in view into the batch, then submit it in a few draw calls
+    static std::vector<size_t> visible;
+    visible.clear();
+    world.queryRegion(view, visible);
+
+    beginFrame();
+    for (size_t index : visible) {
+        drawObject(*world.getObjects()[index]);
+    }
+    drawDebug(world.getDebugDraw());
+    flush();
+}
+
+void Renderer::drawSnapshot(const RenderSnapshot& snapshot) {
+    beginFrame();
+    for (const auto& body : snapshot.bodies) {
+        switch (body.shape) {
+            case SnapshotShape::Circle:
+                drawCircle(body.position, body.size.x, body.color);
+                break;
+            case SnapshotShape::Rectangle:
+                drawRectangle(body.position, body.size.x, body.size.y, body.rotor, body.color);
+                break;
+            case SnapshotShape::Polygon:
+                drawPolygon(body.position, snapshot.polygonVertices.data() + body.firstVertex,
+                            body.vertexCount, body.size.x, body.rotor, body.color);
+                break;
+        }
+        if (snapshot.showVelocityVectors) {
+            drawVelocityVector(body.position, body.velocity * 0.1f);
+        }
+    }
+    drawDebug(snapshot.debugDraw);
+    flush();
+}
+
+void Renderer::drawDebug(const DebugDraw& debug) {
+    for (const auto& v : debug.getLines()) lines.push_back({v.position, v.color});
+    for (const auto& v : debug.getPoints()) points.push_back({v.position, v.color});
+}
@@ -0,0 +1,90 @@
+#include "../include/TraceWriter.hpp"
+#include "../include/PhysicsWorld.hpp"
+#include <iomanip>
+#include <iostream>
+
+TraceWriter::~TraceWriter() {
+    close();
+}
+
+bool TraceWriter::open(const std::string& path) {
+    out.open(path);
+    if (!out) {
+        std::cerr << "Failed to open trace file: " << path << "\n";
+        return false;
+    }
+
+    originNs = Profiler::now();
+    firstEvent = true;
+    writerThread = Profiler::getThreadIndex();
+    namedThreads.clear();
+
+    out << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    return true;
+}
+
+void TraceWriter::close() {
+    if (!out.is_open()) return;
+    out << "\n]}\n";
+    out.close();
+}
+
+void TraceWriter::beginEvent() {
+    out << (firstEvent ? "\n" : ",\n");
+    firstEvent = false;
+}
+
+double TraceWriter::toMicroseconds(uint64_t ns) const {
+    return ns >= originNs ? (ns - originNs) / 1000.0 : 0.0;
+}
+
+void TraceWriter::nameThread(uint32_t thread) {
+    if (thread < namedThreads.size() && namedThreads[thread]) return;
+    if (thread >= namedThreads.size()) namedThreads.resize(thread + 1, false);
+    namedThreads[thread] = true;
+
+    // The thread writing the trace is the one running the updates. Names are
+    // set in code with PROFILE_THREAD_NAME and need no escaping.
+    std::string name = Profiler::getThreadName(thread);
+    if (name.empty()) name = thread == writerThread ? "physics" : "thread " + std::to_string(thread);
+    beginEvent();
+    out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << thread
+        << ",\"args\":{\"name\":\"" << name << "\"}}";
+    beginEvent();
+    out << "{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":1,\"tid\":" << thread
+        << ",\"args\":{\"sort_index\":" << (thread == writerThread ? 0u : thread + 1) << "}}";
+}
+
+void TraceWriter::writeFrame(uint64_t frame) {
+    if (!out.is_open()) return;
+
+    zones.clear();
+    Profiler::collectFrame(frame, zones);
+    for (const auto& zone : zones) {
+        nameThread(zone.thread);
+
+        // Zone names are string literals from PROFILE_ZONE and need no escaping
+        beginEvent();
+        out << "{\"ph\":\"X\",\"name\":\"" << zone.name << "\",\"pid\":1,\"tid\":" << zone.thread
+            << ",\"ts\":" << toMicroseconds(zone.startNs)
+            << ",\"dur\":" << (zone.endNs - zone.startNs) / 1000.0
+            << ",\"args\":{\"frame\":" << zone.frame << "}}";
+    }
+}
+
+void TraceWriter::writeCounter(const char* name, double value) {
+    if (!out.is_open()) return;
+
+    beginEvent();
+    out << "{\"ph\":\"C\",\"name\":\"" << name << "\",\"pid\":1,\"ts\":" << toMicroseconds(Profiler::now())
+        << ",\"args\":{\"value\":" << value << "}}";
+}
+
+void TraceWriter::writeWorldCounters(const PhysicsWorld& world) {
+    writeCounter("bodies", static_cast<double>(world.getObjects().size()));
+    writeCounter("candidate pairs", static_cast<double>(world.getCandidatePairs().size()));
+    writeCounter("contacts", static_cast<double>(world.getContacts().size()));
+    writeCounter("speculative contacts", static_cast<double>(world.getSpeculativeContacts().size()));
+    writeCounter("narrowphase tests", static_cast<double>(world.getStats().totalNarrowphaseTests()));
+    writeCounter("allocations", static_cast<double>(world.getStats().allocations));
+}
@@ -0,0 +1,74 @@
+#include "../include/WorkerPool.hpp"
+#include "../include/Profiler.hpp"
+#include <algorithm>
+#include <string>
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+    stopping = false;
+}
+
+void WorkerPool::resize(size_t count) {
+    if (count == workers.size()) return;
+    stop();
+    for (size_t i = 0; i < count; i++) {
+        workers.emplace_back(&WorkerPool::workerLoop, this, i, generation);
+    }
+}
+
+void WorkerPool::run(size_t slices, const std::function<void(size_t)>& work) {
+    size_t workerSlices = std::min(slices > 0 ? slices - 1 : 0, workers.size());
+
+    // Nothing to hand out: skip the lock and the wake-ups
+    if (workerSlices == 0) {
+        if (slices > 0) work(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &work;
+        activeSlices = workerSlices + 1;
+        remaining = workerSlices;
+        generation++;
+    }
+    workReady.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock, [this] { return remaining == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::workerLoop(size_t index, uint64_t seen) {
+    PROFILE_THREAD_NAME("worker " + std::to_string(index + 1));
+
+    // seen is the generation at start, so only jobs handed out after it are run
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workReady.wait(lock, [this, seen] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+
+        size_t slice = index + 1;
+        if (slice >= activeSlices) continue;
+
+        const std::function<void(size_t)>* work = job;
+        lock.unlock();
+        (*work)(slice);
+        lock.lock();
+
+        if (--remaining == 0) workDone.notify_one();
+    }
+}
@@ -1,18 +1,83 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <memory>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include "../include/PhysicsWorld.hpp"
 #include "../include/Circle.hpp"
 #include "../include/Rectangle.hpp"
 #include "../include/Polygon.hpp"
+#include "../include/Renderer.hpp"
+#include "../include/RenderSnapshot.hpp"
+#include "../include/TripleBuffer.hpp"
+#include "../include/Hud.hpp"
 
 // Global variables
-PhysicsWorld physicsWorld;
-float lastTime = 0.0f;
+PhysicsWorld physicsWorld;     // Owned by the physics thread once it starts
 bool isDragging = false;
-std::shared_ptr<PhysicsObject> draggedObject;
+std::shared_ptr<PhysicsObject> draggedObject; // Only touched by physics commands
 glm::vec2 dragStartPos;
 
+// Part of the world shown in the window; only bodies overlapping it are drawn
+const AABB VIEW_REGION{glm::vec2(-1.0f), glm::vec2(1.0f)};
+
+// Physics runs at a fixed rate on its own thread and publishes snapshots
+// that the main thread draws, so a slow swap never stalls the simulation
+const float PHYSICS_STEP = 1.0f / 120.0f;
+TripleBuffer<RenderSnapshot> snapshots;
+std::atomic<bool> running{true};
+bool showHud = false; // Toggled with H, main thread only
+
+// Input callbacks run on the main thread; anything that touches the world
+// is queued and applied by the physics thread between steps
+std::mutex commandMutex;
+std::vector<std::function<void(PhysicsWorld&)>> pendingCommands;
+std::atomic<bool> hasPendingCommands{false};
+
+void queueCommand(std::function<void(PhysicsWorld&)> command) {
+    std::lock_guard<std::mutex> lock(commandMutex);
+    pendingCommands.push_back(std::move(command));
+    hasPendingCommands.store(true, std::memory_order_release);
+}
+
+void physicsLoop() {
+    std::vector<std::function<void(PhysicsWorld&)>> commands;
+    uint64_t step = 0;
+    auto nextStep = std::chrono::steady_clock::now();
+
+    while (running.load(std::memory_order_relaxed)) {
+        // Only take the lock when the input side has queued something
+        if (hasPendingCommands.load(std::memory_order_acquire)) {
+            {
+                std::lock_guard<std::mutex> lock(commandMutex);
+                commands.swap(pendingCommands);
+                hasPendingCommands.store(false, std::memory_order_relaxed);
+            }
+            for (auto& command : commands) command(physicsWorld);
+            commands.clear();
+        }
+
+        physicsWorld.update(PHYSICS_STEP);
+        step++;
+
+        // Publish the new state for the render thread
+        snapshots.writeBuffer().capture(physicsWorld, step, VIEW_REGION);
+        snapshots.publish();
+
+        // Hold the fixed rate; after a long stall, resume from now instead of catching up
+        nextStep += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(PHYSICS_STEP));
+        auto now = std::chrono::steady_clock::now();
+        if (nextStep < now - std::chrono::milliseconds(100)) nextStep = now;
+        std::this_thread::sleep_until(nextStep);
+    }
+}
+
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_LEFT) {
         double xpos, ypos;
@@ -31,12 +96,14 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
             dragStartPos = worldPos;
         } else if (action == GLFW_RELEASE && isDragging) {
             isDragging = false;
-            if (draggedObject) {
-                // Set velocity based on drag distance
-                glm::vec2 dragVec = worldPos - dragStartPos;
-                draggedObject->setVelocity(dragVec * 5.0f);
-                draggedObject = nullptr;
-            }
+            glm::vec2 dragVec = worldPos - dragStartPos;
+            queueCommand([dragVec](PhysicsWorld&) {
+                if (draggedObject) {
+                    // Set velocity based on drag distance
+                    draggedObject->setVelocity(dragVec * 5.0f);
+                    draggedObject = nullptr;
+                }
+            });
         }
     }
 }
@@ -49,7 +116,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
                 float x = (rand() % 100 - 50) / 50.0f;
                 float y = (rand() % 100 - 50) / 50.0f;
                 auto circle = std::make_shared<Circle>(glm::vec2(x, y), 0.1f, 1.0f);
-                physicsWorld.addObject(circle);
+                queueCommand([circle](PhysicsWorld& world) { world.addObject(circle); });
                 break;
             }
             case GLFW_KEY_P: {
@@ -67,7 +134,7 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
                 
                 auto pentagon = std::make_shared<Polygon>(glm::vec2(x, y), pentagonVerts, 1.0f);
                 pentagon->setColor(glm::vec3(0.2f, 0.8f, 0.3f));  // Green color
-                physicsWorld.addObject(pentagon);
+                queueCommand([pentagon](PhysicsWorld& world) { world.addObject(pentagon); });
                 break;
             }
             case GLFW_KEY_T: {
@@ -84,15 +151,18 @@ void key_callback(GLFWwindow* window, int key, int scancode, int action, int mod
                 
                 auto triangle = std::make_shared<Polygon>(glm::vec2(x, y), triangleVerts, 1.0f);
                 triangle->setColor(glm::vec3(0.8f, 0.2f, 0.3f));  // Red color
-                physicsWorld.addObject(triangle);
+                queueCommand([triangle](PhysicsWorld& world) { world.addObject(triangle); });
                 break;
             }
+            case GLFW_KEY_H:
+                showHud = !showHud;
+                break;
             case GLFW_KEY_R: {
                 // Create rectangle at random position
                 float x = (rand() % 100 - 50) / 50.0f;
                 float y = (rand() % 100 - 50) / 50.0f;
                 auto rect = std::make_shared<Rectangle>(glm::vec2(x, y), 0.2f, 0.15f, 1.0f);
-                physicsWorld.addObject(rect);
+                queueCommand([rect](PhysicsWorld& world) { world.addObject(rect); });
                 break;
             }
         }
@@ -133,29 +203,43 @@ int main() {
     physicsWorld.addObject(circle2);
     physicsWorld.addObject(rect1);
 
-    // Main loop
-    while (!glfwWindowShouldClose(window)) {
-        // Calculate delta time
-        float currentTime = static_cast<float>(glfwGetTime());
-        float deltaTime = currentTime - lastTime;
-        lastTime = currentTime;
+    // Start the simulation; from here on only the physics thread touches the world
+    std::thread physicsThread(physicsLoop);
 
+    // Main loop: draw the newest complete snapshot
+    Hud hud;
+    auto frameStart = std::chrono::steady_clock::now();
+    while (!glfwWindowShouldClose(window)) {
         // Clear the screen
         glClear(GL_COLOR_BUFFER_BIT);
-        
-        // Update physics
-        physicsWorld.update(deltaTime);
+
+        // The world spans -1 to 1, so half the larger side is one unit on screen
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        Renderer::setPixelsPerUnit(0.5f * std::max(framebufferWidth, framebufferHeight));
         
         // Draw all objects
-        physicsWorld.draw();
+        snapshots.update();
+        auto drawStart = std::chrono::steady_clock::now();
+        Renderer::drawSnapshot(snapshots.readBuffer());
+        float drawMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - drawStart).count();
+
+        if (showHud) hud.draw(snapshots.readBuffer(), framebufferWidth, framebufferHeight);
 
         // Swap front and back buffers
         glfwSwapBuffers(window);
 
         // Poll for and process events
         glfwPollEvents();
+
+        auto frameEnd = std::chrono::steady_clock::now();
+        hud.recordFrame(std::chrono::duration<float, std::milli>(frameEnd - frameStart).count(), drawMs);
+        frameStart = frameEnd;
     }
 
+    running.store(false);
+    physicsThread.join();
+
     glfwTerminate();
     return 0;
 }
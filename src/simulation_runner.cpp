@@ -0,0 +1,398 @@
+#include "../include/PhysicsWorld.hpp"
+#include "../include/Circle.hpp"
+#include "../include/Rectangle.hpp"
+#include "../include/Polygon.hpp"
+#include "../include/Profiler.hpp"
+#include "../include/TraceWriter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef RUNNER_OFFSCREEN
+#include "../include/OffscreenContext.hpp"
+#include "../include/FrameWriter.hpp"
+#include "../include/Renderer.hpp"
+#endif
+
+// Headless runner: builds or loads a scene, runs a fixed number of steps as
+// fast as possible and reports throughput, per-phase timings and a checksum
+// of the final state.
+
+struct RunnerOptions {
+    int steps{1000};
+    int threads{1};
+    int bodies{1000};
+    int substeps{1};
+    float dt{1.0f / 60.0f};
+    unsigned seed{1};
+    BroadphaseMode broadphase{BroadphaseMode::SweepAndPrune};
+    std::string broadphaseName{"sap"};
+    std::string scenePath;
+    bool profile{false};    // Print the profiling zones of the last step
+    std::string tracePath;  // Stream a Chrome trace of the window to this file when set
+    int traceFrom{0};
+    int traceSteps{-1};     // Negative traces to the end of the run
+    std::string framesDir;  // Write rendered frames here when set
+    int frameEvery{1};
+    int frameWidth{640};
+    int frameHeight{480};
+};
+
+static void printUsage() {
+    std::cout << "Usage: simulation_runner [options]\n"
+              << "  --steps N          fixed steps to run (default 1000)\n"
+              << "  --threads N        narrowphase threads (default 1)\n"
+              << "  --broadphase MODE  brute, sap or grid (default sap)\n"
+              << "  --bodies N         bodies in the generated scene (default 1000)\n"
+              << "  --scene FILE       load the scene from FILE instead of generating it\n"
+              << "  --substeps N       substeps per step (default 1)\n"
+              << "  --dt SECONDS       step length (default 1/60)\n"
+              << "  --seed N           random seed for the generated scene (default 1)\n"
+              << "  --profile          print the profiling zones of the last step\n"
+              << "  --trace FILE       write profiling zones and counters as Chrome trace JSON\n"
+              << "  --trace-from N     first step to trace (default 0)\n"
+              << "  --trace-steps N    steps to trace (default: to the end)\n"
+#ifdef RUNNER_OFFSCREEN
+              << "  --frames DIR       render offscreen and write frames to DIR as PPM\n"
+              << "  --frame-every N    render every Nth step (default 1)\n"
+              << "  --frame-size WxH   frame size in pixels (default 640x480)\n"
+#endif
+              << "\n"
+              << "Scene files hold one body per line, '#' starts a comment:\n"
+              << "  circle  x y radius [vx vy]\n"
+              << "  rect    x y width height [vx vy]\n"
+              << "  polygon x y size sides [vx vy]\n"
+              << "  world   width height\n";
+}
+
+static bool parseOptions(int argc, char** argv, RunnerOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return false;
+        }
+        if (arg == "--profile") {
+            options.profile = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+
+        // Conversions throw on values that are not numbers or out of range
+        try {
+            if (arg == "--steps") options.steps = std::stoi(value);
+            else if (arg == "--threads") options.threads = std::stoi(value);
+            else if (arg == "--bodies") options.bodies = std::stoi(value);
+            else if (arg == "--substeps") options.substeps = std::stoi(value);
+            else if (arg == "--dt") options.dt = std::stof(value);
+            else if (arg == "--seed") options.seed = static_cast<unsigned>(std::stoul(value));
+            else if (arg == "--scene") options.scenePath = value;
+            else if (arg == "--trace") options.tracePath = value;
+            else if (arg == "--trace-from") options.traceFrom = std::stoi(value);
+            else if (arg == "--trace-steps") options.traceSteps = std::stoi(value);
+#ifdef RUNNER_OFFSCREEN
+            else if (arg == "--frames") options.framesDir = value;
+            else if (arg == "--frame-every") options.frameEvery = std::max(1, std::stoi(value));
+            else if (arg == "--frame-size") {
+                size_t split = value.find('x');
+                if (split == std::string::npos) {
+                    std::cerr << "Frame size must look like 640x480: " << value << "\n";
+                    return false;
+                }
+                options.frameWidth = std::stoi(value.substr(0, split));
+                options.frameHeight = std::stoi(value.substr(split + 1));
+            }
+#endif
+            else if (arg == "--broadphase") {
+                options.broadphaseName = value;
+                if (value == "brute") options.broadphase = BroadphaseMode::BruteForce;
+                else if (value == "sap") options.broadphase = BroadphaseMode::SweepAndPrune;
+                else if (value == "grid") options.broadphase = BroadphaseMode::UniformGrid;
+                else {
+                    std::cerr << "Unknown broadphase mode: " << value << "\n";
+                    return false;
+                }
+            }
+            else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                printUsage();
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << value << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::vector<glm::vec2> makeRegularPolygon(float size, int sides) {
+    std::vector<glm::vec2> verts;
+    for (int i = 0; i < sides; i++) {
+        float angle = (i * 2.0f * 3.14159f) / sides;
+        verts.push_back(size * glm::vec2(std::cos(angle), std::sin(angle)));
+    }
+    return verts;
+}
+
+// Bodies on a jittered grid inside a square world sized to fit them
+static std::unique_ptr<PhysicsWorld> generateScene(const RunnerOptions& options) {
+    const float SPACING = 0.1f;
+    int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(options.bodies)))));
+    float worldSize = (columns + 1) * SPACING;
+    auto world = std::make_unique<PhysicsWorld>(worldSize, worldSize);
+
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    for (int i = 0; i < options.bodies; i++) {
+        glm::vec2 position(
+            -worldSize / 2 + SPACING * (i % columns + 1) + (unit(rng) - 0.5f) * 0.02f,
+            -worldSize / 2 + SPACING * (i / columns + 1) + (unit(rng) - 0.5f) * 0.02f);
+        glm::vec2 velocity((unit(rng) - 0.5f) * 2.0f, (unit(rng) - 0.5f) * 2.0f);
+        float size = 0.02f + unit(rng) * 0.02f;
+
+        // Mostly circles, with some boxes and polygons
+        std::shared_ptr<PhysicsObject> body;
+        float kind = unit(rng);
+        if (kind < 0.6f) {
+            body = std::make_shared<Circle>(position, size);
+        } else if (kind < 0.8f) {
+            body = std::make_shared<Rectangle>(position, size * 2.0f, size * 1.5f);
+        } else {
+            body = std::make_shared<Polygon>(position, makeRegularPolygon(size, 3 + static_cast<int>(unit(rng) * 5)));
+        }
+        body->setVelocity(velocity);
+        body->setRotation(unit(rng) * 6.28318f);
+        world->addObject(body);
+    }
+    return world;
+}
+
+static std::unique_ptr<PhysicsWorld> loadScene(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open scene file: " << path << "\n";
+        return nullptr;
+    }
+
+    auto world = std::make_unique<PhysicsWorld>();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream in(line);
+        std::string kind;
+        if (!(in >> kind)) continue;
+
+        glm::vec2 position;
+        std::shared_ptr<PhysicsObject> body;
+        if (kind == "world") {
+            float width, height;
+            if (in >> width >> height) {
+                // Keep any bodies already read
+                auto resized = std::make_unique<PhysicsWorld>(width, height);
+                for (const auto& obj : world->getObjects()) resized->addObject(obj);
+                world = std::move(resized);
+                continue;
+            }
+        } else if (kind == "circle") {
+            float radius;
+            if (in >> position.x >> position.y >> radius) body = std::make_shared<Circle>(position, radius);
+        } else if (kind == "rect") {
+            float width, height;
+            if (in >> position.x >> position.y >> width >> height) {
+                body = std::make_shared<Rectangle>(position, width, height);
+            }
+        } else if (kind == "polygon") {
+            float size;
+            int sides;
+            if (in >> position.x >> position.y >> size >> sides && sides >= 3) {
+                body = std::make_shared<Polygon>(position, makeRegularPolygon(size, sides));
+            }
+        }
+
+        if (!body) {
+            std::cerr << path << ":" << lineNumber << ": cannot parse '" << line << "'\n";
+            return nullptr;
+        }
+
+        glm::vec2 velocity;
+        if (in >> velocity.x >> velocity.y) body->setVelocity(velocity);
+        world->addObject(body);
+    }
+    return world;
+}
+
+// FNV-1a over the bit patterns of every body's state, so any divergence shows
+static uint64_t stateChecksum(const PhysicsWorld& world) {
+    uint64_t hash = 1469598103934665603ull;
+    auto mix = [&hash](float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 4; i++) {
+            hash ^= (bits >> (8 * i)) & 0xffu;
+            hash *= 1099511628211ull;
+        }
+    };
+    for (const auto& obj : world.getObjects()) {
+        mix(obj->getPosition().x);
+        mix(obj->getPosition().y);
+        mix(obj->getVelocity().x);
+        mix(obj->getVelocity().y);
+        mix(obj->getRotation());
+    }
+    return hash;
+}
+
+#ifdef RUNNER_OFFSCREEN
+// Draw the whole world into the offscreen frame, keeping its aspect ratio
+static void renderFrame(const PhysicsWorld& world, const OffscreenContext& context) {
+    float scale = std::min(context.getWidth() / world.getWidth(), context.getHeight() / world.getHeight());
+    glm::vec2 halfView(0.5f * context.getWidth() / scale, 0.5f * context.getHeight() / scale);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(-halfView.x, halfView.x, -halfView.y, halfView.y, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    glClear(GL_COLOR_BUFFER_BIT);
+    Renderer::setPixelsPerUnit(scale);
+    Renderer::drawWorld(world, AABB{-halfView, halfView});
+}
+#endif
+
+int main(int argc, char** argv) {
+    RunnerOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    auto world = options.scenePath.empty() ? generateScene(options) : loadScene(options.scenePath);
+    if (!world) return 1;
+
+    world->setBroadphaseMode(options.broadphase);
+    world->setThreadCount(options.threads);
+    world->setSubsteps(options.substeps);
+
+#ifdef RUNNER_OFFSCREEN
+    // Frames are rendered and read back here; encoding and disk writes happen on the writer's thread
+    std::unique_ptr<OffscreenContext> context;
+    std::unique_ptr<FrameWriter> frameWriter;
+    double frameSeconds = 0.0;
+    if (!options.framesDir.empty()) {
+        context = std::make_unique<OffscreenContext>();
+        if (!context->initialize(options.frameWidth, options.frameHeight)) return 1;
+        frameWriter = std::make_unique<FrameWriter>();
+    }
+#endif
+
+    // Each traced step is written out as soon as it finishes
+    TraceWriter trace;
+    if (!options.tracePath.empty() && !trace.open(options.tracePath)) return 1;
+    int traceEnd = options.traceSteps < 0 ? options.steps : options.traceFrom + options.traceSteps;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < options.steps; step++) {
+        world->update(options.dt);
+
+        if (trace.isOpen() && step >= options.traceFrom && step < traceEnd) {
+            trace.writeFrame(Profiler::getFrame());
+            trace.writeWorldCounters(*world);
+        }
+
+#ifdef RUNNER_OFFSCREEN
+        if (frameWriter && step % options.frameEvery == 0) {
+            auto frameStart = std::chrono::steady_clock::now();
+            renderFrame(*world, *context);
+            std::vector<uint8_t> pixels = frameWriter->takeBuffer();
+            context->readPixels(pixels);
+
+            char name[32];
+            std::snprintf(name, sizeof(name), "/frame_%06d.ppm", step);
+            frameWriter->submit(options.framesDir + name, context->getWidth(), context->getHeight(),
+                                std::move(pixels));
+            frameSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+        }
+#endif
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+#ifdef RUNNER_OFFSCREEN
+    if (frameWriter) {
+        frameWriter->finish();
+        std::cout << std::fixed << std::setprecision(3)
+                  << "frames       " << frameWriter->getFramesWritten() << " written to " << options.framesDir
+                  << " (" << frameSeconds << " s rendering in the loop)\n";
+        if (frameWriter->hasFailed()) return 1;
+    }
+#endif
+
+    const PhaseTimings& timings = world->getTimings();
+    double perStep = options.steps > 0 ? 1.0 / options.steps : 0.0;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "bodies       " << world->getObjects().size() << "\n"
+              << "steps        " << options.steps << "\n"
+              << "threads      " << world->getThreadCount() << "\n"
+              << "broadphase   " << options.broadphaseName << "\n"
+              << "wall time    " << seconds << " s\n"
+              << "steps/sec    " << (seconds > 0.0 ? options.steps / seconds : 0.0) << "\n"
+              << "phase ms     total / per step\n"
+              << "  broadphase   " << timings.broadphase << " / " << timings.broadphase * perStep << "\n"
+              << "  narrowphase  " << timings.narrowphase << " / " << timings.narrowphase * perStep << "\n"
+              << "  solver       " << timings.solver << " / " << timings.solver * perStep << "\n"
+              << "  integration  " << timings.integration << " / " << timings.integration * perStep << "\n";
+
+    // Where the last step's work went
+    const PipelineStats& stats = world->getStats();
+    std::cout << "last step    " << stats.dynamicBodies << " dynamic, " << stats.staticBodies << " static bodies\n"
+              << "  pairs        " << stats.candidatePairs << "\n"
+              << "  tests        " << stats.totalNarrowphaseTests() << "\n";
+    for (int a = 0; a < PipelineStats::SHAPE_KINDS; a++) {
+        for (int b = a; b < PipelineStats::SHAPE_KINDS; b++) {
+            if (stats.narrowphaseTests[a][b] == 0) continue;
+            std::string name = std::string(PipelineStats::SHAPE_NAMES[a]) + "-" + PipelineStats::SHAPE_NAMES[b];
+            std::cout << "    " << std::left << std::setw(20) << name << std::right
+                      << stats.narrowphaseTests[a][b] << "\n";
+        }
+    }
+    std::cout << "  hits         " << stats.hits << " (" << stats.contactPoints << " contact points, "
+              << stats.speculativeContacts << " speculative)\n"
+              << "  iterations   " << stats.solverIterations << "\n"
+              << "  allocations  " << stats.allocations << "\n"
+              << "checksum     " << std::hex << std::setw(16) << std::setfill('0') << stateChecksum(*world) << "\n";
+
+    if (options.profile) {
+#ifdef COLLISION_DISABLE_PROFILING
+        std::cout << "profiling zones were compiled out (COLLISION_PROFILING=OFF)\n";
+#else
+        // Zones of the last step, indented by nesting depth
+        std::vector<ProfileZone> zones;
+        Profiler::collectFrame(Profiler::getFrame(), zones);
+        std::cout << std::dec << std::setfill(' ') << "zones        thread  ms (last step)\n";
+        for (const auto& zone : zones) {
+            std::cout << "  " << std::string(zone.depth * 2, ' ') << std::left << std::setw(24 - zone.depth * 2)
+                      << zone.name << std::right << std::setw(4) << zone.thread << "  "
+                      << (zone.endNs - zone.startNs) / 1e6 << "\n";
+        }
+#endif
+    }
+    return 0;
+}